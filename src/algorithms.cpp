@@ -4,56 +4,268 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include "algorithms.h"
+#include "kernels.h"
+#include "threadpool.h"
 #include <climits>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <queue>
 
 // ====================================================================== //
 // ========================= EXHAUSTIVE SEARCH ========================== //
 // ====================================================================== //
 
+/**
+ * @struct MaskCandidate
+ * @brief A subset of pallets given by its bitmask, with its totals.
+ */
+struct MaskCandidate {
+    long long profit;
+    long long weight;
+    uint64_t mask;
+};
+
+/**
+ * @brief Total order used to pick the exhaustive search answer.
+ *
+ * Higher profit wins, then lower weight, then the smaller mask. The last
+ * rule reproduces the first-found mask of an increasing-order scan and makes
+ * the result independent of how the mask space was split among threads.
+ */
+bool betterCandidate(const MaskCandidate& a, const MaskCandidate& b) {
+    if (a.profit != b.profit) return a.profit > b.profit;
+    if (a.weight != b.weight) return a.weight < b.weight;
+    return a.mask < b.mask;
+}
+
 /**
  * @brief Solves the knapsack problem using exhaustive (brute-force) search.
  * 
  * Iterates through all 2^n combinations of pallets, checking which subset
  * fits within the weight capacity and yields the maximum profit. Among
  * multiple optimal solutions, selects the one with lowest total weight.
+ *
+ * The mask space is cut into chunks that fix the highest pallets, and
+ * worker threads claim chunks from a shared counter. Inside a chunk the
+ * remaining pallets are walked in Gray-code order, so each mask costs one
+ * addition or subtraction. Each thread keeps its own best, and the bests
+ * are reduced with betterCandidate(), so the answer does not depend on the
+ * thread count.
  * 
- * @param pallets Vector of pallet objects with weight and profit
- * @param capacity Maximum weight capacity of the truck
- * @return Vector of selected pallets (non-selected are returned as {0,0})
+ * @param instance Pallets (at most 63) and truck capacity
+ * @param threads Number of threads to use (0 = all hardware threads)
+ * @param token Optional stop request; the best subset seen so far is returned
+ * @return Selected pallets
  * 
- * @complexity Time: O(2^n * n) - Evaluates all subsets
- * @complexity Space: O(n) - Stores the best combination mask
- */
-std::vector<Pallet> exhaustiveSearch(const std::vector<Pallet>& pallets, int capacity) {
-    size_t n = pallets.size();
-    int bestProfit = 0;
-    int bestWeight = INT_MAX;
-    int bestMask = 0;
-
-    for (size_t mask = 0; mask < ((size_t)1 << n); mask++) {
-        int totalWeight = 0;
-        int totalProfit = 0;
-        
-        for (size_t i = 0; i < n; i++) {
-            if ((mask >> i) & 1) {
-                totalWeight += pallets[i].weight;
-                totalProfit += pallets[i].profit;
+ * @complexity Time: O(2^n / threads) - Constant work per subset
+ * @complexity Space: O(n + threads) - Per-thread best candidates
+ */
+Solution exhaustiveSearch(const Instance& instance, int threads, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    const int* w = instance.weights();
+    const int* p = instance.profits();
+    Solution result(n);
+    if (n > 63) {
+        std::cerr << "Exhaustive search supports at most 63 pallets.\n";
+        return result;
+    }
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Highest chunkBits pallets are fixed per chunk, the rest are walked
+    int chunkBits = std::min(n, 10);
+    int walkBits = n - chunkBits;
+    uint64_t chunkCount = (uint64_t)1 << chunkBits;
+    threads = (int)std::min<uint64_t>(threads, chunkCount);
+
+    std::atomic<uint64_t> nextChunk(0);
+    std::vector<MaskCandidate> bests(threads, MaskCandidate{-1, 0, 0});
+
+    auto work = [&](int t) {
+        MaskCandidate best = {-1, 0, 0};
+        for (uint64_t chunk = nextChunk++; chunk < chunkCount && !stopRequested(token); chunk = nextChunk++) {
+            uint64_t mask = chunk << walkBits;
+            long long weight = 0, profit = 0;
+            for (int i = walkBits; i < n; i++) {
+                if ((mask >> i) & 1) {
+                    weight += w[i];
+                    profit += p[i];
+                }
             }
-        }
 
-        if (totalWeight <= capacity) {
-            if (totalProfit > bestProfit || (totalProfit == bestProfit && totalWeight < bestWeight)) {
-                bestProfit = totalProfit;
-                bestWeight = totalWeight;
-                bestMask = mask;
+            if (weight <= capacity && betterCandidate({profit, weight, mask}, best)) {
+                best = {profit, weight, mask};
+            }
+            for (uint64_t k = 1; k < ((uint64_t)1 << walkBits); k++) {
+                if ((k & 0xFFFFF) == 0 && stopRequested(token)) break;
+                int bit = __builtin_ctzll(k);
+                mask ^= (uint64_t)1 << bit;
+                if ((mask >> bit) & 1) {
+                    weight += w[bit];
+                    profit += p[bit];
+                } else {
+                    weight -= w[bit];
+                    profit -= p[bit];
+                }
+                if (weight <= capacity && profit >= best.profit && betterCandidate({profit, weight, mask}, best)) {
+                    best = {profit, weight, mask};
+                }
             }
         }
+        bests[t] = best;
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(work, t);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+
+    MaskCandidate best = bests[0];
+    for (const MaskCandidate& candidate : bests) {
+        if (betterCandidate(candidate, best)) best = candidate;
     }
-    
-    std::vector<Pallet> result(n);
-    for (size_t i = 0; i < n; i++) {
-        result[i] = ((bestMask >> i) & 1) ? pallets[i] : Pallet{0, 0};
+
+    for (int i = 0; i < n; i++) {
+        if ((best.mask >> i) & 1) result.take(instance, i);
+    }
+    return result;
+}
+
+// ====================================================================== //
+// ========================= MEET IN THE MIDDLE ========================= //
+// ====================================================================== //
+
+/**
+ * @struct HalfSubset
+ * @brief Totals of one subset of a half of the pallets, with its bitmask.
+ */
+struct HalfSubset {
+    long long profit;
+    uint32_t weight;   ///< Fits in 32 bits, only subsets within capacity are kept
+    uint32_t mask;
+};
+
+/**
+ * @brief Enumerates the subsets of pallets [first, first + count) in Gray-code order.
+ *
+ * Consecutive Gray codes differ in one bit, so each subset is derived from
+ * the previous one with a single addition or subtraction. visit is called
+ * for every subset whose weight fits in capacity, the empty one included.
+ *
+ * @param instance Pallets and truck capacity
+ * @param first Index of the first pallet of the half
+ * @param count Number of pallets in the half (at most 32)
+ * @param token Optional stop request, polled every 65536 subsets
+ * @param visit Callback receiving each fitting HalfSubset
+ *
+ * @complexity Time: O(2^count) - Constant work per subset
+ * @complexity Space: O(1)
+ */
+template<typename Visit>
+void enumerateGrayCode(const Instance& instance, int first, int count, const CancellationToken* token,
+                       Visit&& visit) {
+    const int* w = instance.weights() + first;
+    const int* p = instance.profits() + first;
+    long long capacity = instance.capacity();
+    long long weight = 0, profit = 0;
+    uint32_t mask = 0;
+    visit(HalfSubset{0, 0, 0});
+    for (uint64_t k = 1; k < ((uint64_t)1 << count); k++) {
+        if ((k & 0xFFFF) == 0 && stopRequested(token)) return;
+        int bit = __builtin_ctzll(k);
+        mask ^= (uint32_t)1 << bit;
+        if ((mask >> bit) & 1) {
+            weight += w[bit];
+            profit += p[bit];
+        } else {
+            weight -= w[bit];
+            profit -= p[bit];
+        }
+        if (weight <= capacity) visit(HalfSubset{profit, (uint32_t)weight, mask});
+    }
+}
+
+/**
+ * @brief Solves the knapsack problem exactly by meet in the middle.
+ *
+ * Splits the pallets into two halves. The subsets of the second half are
+ * enumerated, sorted by weight and reduced to a frontier whose profit
+ * strictly increases with weight. Every subset of the first half then
+ * binary-searches that frontier for the best partner that still fits.
+ * Among optimal loads the lightest one is returned, as in exhaustiveSearch().
+ * Masks are 64-bit, so up to 64 pallets are supported. A stopped
+ * enumeration only skips subsets, so the load returned still fits.
+ *
+ * @param instance Pallets (at most 64) and truck capacity
+ * @param token Optional stop request
+ * @return Selected pallets
+ *
+ * @complexity Time: O(2^(n/2) * n) - Sorting the second half dominates
+ * @complexity Space: O(2^(n/2)) - Subsets of the second half
+ */
+Solution meetInTheMiddle(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (n > 64) {
+        std::cerr << "Meet in the middle supports at most 64 pallets.\n";
+        return result;
+    }
+    if (capacity < 0) return result;
+
+    int countA = n - n / 2;
+    int countB = n / 2;
+
+    std::vector<HalfSubset> frontier;
+    frontier.reserve((size_t)1 << countB);
+    enumerateGrayCode(instance, countA, countB, token, [&](const HalfSubset& subset) {
+        frontier.push_back(subset);
+    });
+    if (stopRequested(token)) return result;
+    std::sort(frontier.begin(), frontier.end(), [](const HalfSubset& a, const HalfSubset& b) {
+        if (a.weight != b.weight) return a.weight < b.weight;
+        return a.profit > b.profit;
+    });
+
+    // Keep only subsets that beat every lighter one
+    size_t kept = 0;
+    for (size_t i = 0; i < frontier.size(); i++) {
+        if (kept == 0 || frontier[i].profit > frontier[kept - 1].profit) {
+            frontier[kept++] = frontier[i];
+        }
+    }
+    frontier.resize(kept);
+    frontier.shrink_to_fit();
+
+    long long bestProfit = -1, bestWeight = 0;
+    uint64_t bestMask = 0;
+    long long bestPartnerProfit = frontier.back().profit;
+    enumerateGrayCode(instance, 0, countA, token, [&](const HalfSubset& subset) {
+        // Not even the most profitable partner could catch up
+        if (subset.profit + bestPartnerProfit < bestProfit) return;
+
+        long long room = capacity - subset.weight;
+        auto it = std::upper_bound(frontier.begin(), frontier.end(), room, [](long long w, const HalfSubset& b) {
+            return w < (long long)b.weight;
+        });
+        const HalfSubset& partner = *(it - 1);
+        long long profit = subset.profit + partner.profit;
+        long long weight = subset.weight + partner.weight;
+        if (profit > bestProfit || (profit == bestProfit && weight < bestWeight)) {
+            bestProfit = profit;
+            bestWeight = weight;
+            bestMask = subset.mask | ((uint64_t)partner.mask << countA);
+        }
+    });
+
+    for (int i = 0; i < n; i++) {
+        if ((bestMask >> i) & 1) result.take(instance, i);
     }
     return result;
 }
@@ -63,77 +275,122 @@ std::vector<Pallet> exhaustiveSearch(const std::vector<Pallet>& pallets, int cap
 // ====================================================================== //
 
 /**
- * @brief Recursive helper for backtracking solution of 0/1 knapsack.
- * 
- * Explores all subsets through recursive inclusion/exclusion of items,
- * tracking both maximum profit and minimum weight for optimal solutions.
- * 
- * @param pallets Vector of pallet objects
- * @param currentIndex Current recursion depth
- * @param currentWeight Accumulated weight in current path
- * @param currentProfit Accumulated profit in current path
- * @param capacity Maximum allowed weight
- * @param currentTake Current selection status of items
- * @param bestTake Best found selection status
- * @param bestProfit Reference to best profit found
- * @param bestWeight Reference to best weight for optimal solutions
- * 
+ * @struct DepthFirstArena
+ * @brief Preallocated stack and path bitsets of an iterative depth-first search.
+ *
+ * The searches dive into the inclusion branch first and leave only the
+ * exclusion sibling open, so at most one node per level waits on the stack:
+ * n + 1 entries, allocated once. The path is one bit per level, valid below
+ * the current level; the incumbent is a second bitset, overwritten in place
+ * on improvement. Nothing is allocated while the search runs.
+ */
+struct DepthFirstArena {
+    struct Node {
+        long long weight;
+        long long profit;
+        int level;  ///< The node excludes the pallet at level - 1
+    };
+
+    std::vector<Node> stack;
+    std::vector<uint64_t> path;
+    std::vector<uint64_t> best;
+    int top = 0;
+
+    explicit DepthFirstArena(int n) : stack(n + 1), path(n / 64 + 1, 0), best(n / 64 + 1, 0) {}
+
+    void mark(int level, bool take) {
+        uint64_t bit = (uint64_t)1 << (level & 63);
+        path[level >> 6] = take ? path[level >> 6] | bit : path[level >> 6] & ~bit;
+    }
+
+    /// Leaves the exclusion sibling of the pallet at level open
+    void pushSibling(int level, long long weight, long long profit) { stack[top++] = {weight, profit, level + 1}; }
+
+    /**
+     * @brief Resumes at the most recent open sibling.
+     * @return False once the stack is empty and the search is over
+     */
+    bool pop(int& level, long long& weight, long long& profit) {
+        if (top == 0) return false;
+        const Node& node = stack[--top];
+        level = node.level;
+        weight = node.weight;
+        profit = node.profit;
+        mark(level - 1, false);
+        return true;
+    }
+
+    /// Clears every bit of bits from level on
+    static void clearFrom(std::vector<uint64_t>& bits, int level) {
+        bits[level >> 6] &= ((uint64_t)1 << (level & 63)) - 1;
+        std::fill(bits.begin() + (level >> 6) + 1, bits.end(), 0);
+    }
+
+    void recordBest() { std::copy(path.begin(), path.end(), best.begin()); }
+
+    /// Records the load of a node at level: its path below level, nothing after
+    void recordBest(int level) {
+        recordBest();
+        clearFrom(best, level);
+    }
+    bool inPath(int level) const { return (path[level >> 6] >> (level & 63)) & 1; }
+    bool inBest(int level) const { return (best[level >> 6] >> (level & 63)) & 1; }
+};
+
+/**
+ * @brief Solves 0/1 knapsack by backtracking over every feasible subset.
+ *
+ * Explores all subsets by inclusion then exclusion of each pallet, in input
+ * order, keeping the maximum profit and, among equal profits, the minimum
+ * weight. The search is iterative over a DepthFirstArena, so there is no
+ * recursion-depth limit and the incumbent costs n / 64 words to update.
+ *
+ * @param instance Pallets and truck capacity
+ * @param token Optional stop request, polled every 65536 nodes; the best load so far is returned
+ * @param nodes If not null, receives the number of nodes expanded
+ * @return Selected pallets
+ *
  * @complexity Time: O(2^n) - Worst case explores all combinations
- * @complexity Space: O(n) - Recursion depth and tracking vectors
- */
-void backtrackingHelper(
-    const std::vector<Pallet>& pallets,
-    int currentIndex,
-    long long currentWeight,
-    long long currentProfit,
-    int capacity,
-    std::vector<int>& currentTake,
-    std::vector<int>& bestTake,
-    long long& bestProfit,
-    long long& bestWeight
-) {
-    int n = pallets.size();
-    if (currentIndex == n) {
-        if (currentProfit > bestProfit || (currentProfit == bestProfit && currentWeight < bestWeight)) {
-            bestProfit = currentProfit;
-            bestWeight = currentWeight;
-            bestTake = currentTake;
-        }
-        return;
-    }
-
-    Pallet pallet = pallets[currentIndex];
-    if (currentWeight + pallet.weight <= capacity) {
-        currentTake[currentIndex] = 1;
-        backtrackingHelper(
-            pallets, currentIndex + 1,
-            currentWeight + pallet.weight,
-            currentProfit + pallet.profit,
-            capacity, currentTake, bestTake,
-            bestProfit, bestWeight
-        );
-        currentTake[currentIndex] = 0;
-    }
-
-    backtrackingHelper(
-        pallets, currentIndex + 1,
-        currentWeight, currentProfit,
-        capacity, currentTake, bestTake,
-        bestProfit, bestWeight
-    );
-}
-
-std::vector<Pallet> backtracking(const std::vector<Pallet>& pallets, int capacity) {
-    int n = pallets.size();
-    std::vector<int> bestTake(n, 0), currTake(n, 0);
-    long long bestProfit = 0;
-    long long bestWeight = LLONG_MAX;
+ * @complexity Space: O(n) - Stack and two bitsets
+ */
+Solution backtracking(const Instance& instance, const CancellationToken* token, long long* nodes) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    const int* weights = instance.weights();
+    const int* profits = instance.profits();
+
+    DepthFirstArena arena(n);
+    long long bestProfit = 0, bestWeight = LLONG_MAX;
+    long long steps = 0;
+
+    int level = 0;
+    long long weight = 0, profit = 0;
+    while (true) {
+        if ((++steps & 0xFFFF) == 0 && stopRequested(token)) break;
+
+        if (level == n) {
+            if (profit > bestProfit || (profit == bestProfit && weight < bestWeight)) {
+                bestProfit = profit;
+                bestWeight = weight;
+                arena.recordBest();
+            }
+            if (!arena.pop(level, weight, profit)) break;
+            continue;
+        }
 
-    backtrackingHelper(pallets, 0, 0, 0, capacity, currTake, bestTake, bestProfit, bestWeight);
+        bool fits = weight + weights[level] <= capacity;
+        if (fits) {
+            arena.pushSibling(level, weight, profit);
+            weight += weights[level];
+            profit += profits[level];
+        }
+        arena.mark(level++, fits);
+    }
+    if (nodes) *nodes = steps;
 
-    std::vector<Pallet> result(n);
+    Solution result(n);
     for (int i = 0; i < n; i++) {
-        result[i] = bestTake[i] ? pallets[i] : Pallet{0, 0};
+        if (arena.inBest(i)) result.take(instance, i);
     }
     return result;
 }
@@ -149,23 +406,25 @@ std::vector<Pallet> backtracking(const std::vector<Pallet>& pallets, int capacit
  * all possible pallet combinations. Returns the optimal subset with
  * maximum profit and minimum weight when multiple optima exist.
  * 
- * @param pallets Vector of pallet objects
- * @param capacity Truck weight capacity
- * @return Selected pallets vector with optimal profit/weight
+ * @param instance Pallets and truck capacity
+ * @return Selected pallets with optimal profit/weight
  * 
  * @complexity Time: O(2^n) - Pruned search space through backtracking
  * @complexity Space: O(n) - Recursion stack and tracking vectors
  */
-std::vector<Pallet> dynamicProgramming(const std::vector<Pallet>& pallets, int capacity) {
-    int n = pallets.size();
+Solution dynamicProgramming(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
     std::vector<std::vector<int>> dp(n + 1, std::vector<int>(capacity + 1));
 
     for (int i = 1; i <= n; i++) {
-        Pallet currentPallet = pallets[i - 1];
+        if (stopRequested(token)) return Solution(n);
+        int weight = instance.weight(i - 1);
+        int profit = instance.profit(i - 1);
         for (int j = 0; j <= capacity; j++) {
             dp[i][j] = dp[i - 1][j];
-            if (j - currentPallet.weight >= 0) {
-                dp[i][j] = std::max(dp[i][j], dp[i - 1][j - currentPallet.weight] + currentPallet.profit);
+            if (j - weight >= 0) {
+                dp[i][j] = std::max(dp[i][j], dp[i - 1][j - weight] + profit);
             }
         }
     }
@@ -178,12 +437,12 @@ std::vector<Pallet> dynamicProgramming(const std::vector<Pallet>& pallets, int c
         }
     }
 
-    std::vector<Pallet> result(n);
+    Solution result(n);
     int i = n, j = minWeight;
     while (i > 0 && j >= 0) {
         if (dp[i][j] != dp[i - 1][j]) {
-            result[i - 1] = pallets[i - 1];
-            j -= pallets[i - 1].weight;
+            result.take(instance, i - 1);
+            j -= instance.weight(i - 1);
         }
         i--;
     }
@@ -191,108 +450,799 @@ std::vector<Pallet> dynamicProgramming(const std::vector<Pallet>& pallets, int c
 }
 
 // ====================================================================== //
-// ======================= APPROXIMATION ALGORITHM ====================== //
+// ================== LINEAR-MEMORY DYNAMIC PROGRAMMING ================= //
 // ====================================================================== //
 
+/**
+ * @brief Computes the 0/1 knapsack profile of a contiguous range of pallets.
+ *
+ * After the call, row[j] holds the best profit achievable with pallets
+ * [first, last) and at most j units of weight. A single row is updated
+ * in place from the highest capacity down, so no per-item table is kept.
+ *
+ * @param instance Pallets
+ * @param first Index of the first pallet in the range
+ * @param last One past the index of the last pallet in the range
+ * @param capacity Largest capacity to evaluate
+ * @param row Output profile, resized to capacity + 1
+ * @param token Optional stop request, polled once per pallet
+ * @return False if stopped before the profile was complete
+ *
+ * @complexity Time: O((last - first) * capacity)
+ * @complexity Space: O(capacity)
+ */
+bool knapsackProfile(const Instance& instance, int first, int last, int capacity, std::vector<int>& row,
+                     const CancellationToken* token) {
+    row.assign(capacity + 1, 0);
+    for (int i = first; i < last; i++) {
+        if (stopRequested(token)) return false;
+        int weight = instance.weight(i);
+        int profit = instance.profit(i);
+        for (int j = capacity; j >= weight; j--) {
+            row[j] = std::max(row[j], row[j - weight] + profit);
+        }
+    }
+    return true;
+}
 
 /**
- * @brief Greedy heuristic using profit/weight ratio sorting.
- * 
- * Sorts pallets by descending profit/weight ratio, selects items until
- * capacity is full.
- * 
- * @param pallets Vector of pallet objects
- * @param capacity Truck weight limit
- * @return Subset of pallets selected by greedy criteria
- * 
- * @complexity Time: O(n log n) - Sorting dominates complexity
- * @complexity Space: O(n) - Stores sorted items and result
+ * @brief Recovers an optimal pallet subset by divide-and-conquer recomputation.
+ *
+ * Splits the range in two halves, computes the profile of each half and
+ * picks the capacity split that maximizes their combined profit. Both
+ * rows are released before recursing, so only O(capacity) values are
+ * alive at any time.
+ *
+ * @param instance Pallets
+ * @param first Index of the first pallet in the range
+ * @param last One past the index of the last pallet in the range
+ * @param capacity Capacity assigned to this range
+ * @param take Output load
+ * @param token Optional stop request
+ * @return False if stopped, take is then incomplete
+ *
+ * @complexity Time: O((last - first) * capacity) - Halving keeps the total at about twice one pass
+ * @complexity Space: O(capacity + log n) - Two rows per level, freed before descending
+ */
+bool hirschbergReconstruct(const Instance& instance, int first, int last, int capacity, Solution& take,
+                           const CancellationToken* token) {
+    if (last - first == 1) {
+        if (instance.weight(first) <= capacity && instance.profit(first) > 0) {
+            take.take(instance, first);
+        }
+        return true;
+    }
+
+    int mid = first + (last - first) / 2;
+    int split = 0;
+    {
+        std::vector<int> left, right;
+        if (!knapsackProfile(instance, first, mid, capacity, left, token)) return false;
+        if (!knapsackProfile(instance, mid, last, capacity, right, token)) return false;
+
+        int best = -1;
+        for (int c = 0; c <= capacity; c++) {
+            if (left[c] + right[capacity - c] >= best) {
+                best = left[c] + right[capacity - c];
+                split = c;
+            }
+        }
+    }
+
+    return hirschbergReconstruct(instance, first, mid, split, take, token) &&
+           hirschbergReconstruct(instance, mid, last, capacity - split, take, token);
+}
+
+/**
+ * @brief Solves 0/1 knapsack with dynamic programming in O(capacity) memory.
+ *
+ * A single rolling row yields the maximum profit and the smallest weight
+ * that attains it. The subset is then rebuilt Hirschberg-style with that
+ * smallest weight as the capacity, so the returned load has the same
+ * profit and the same minimum weight as dynamicProgramming().
+ *
+ * @param instance Pallets and truck capacity
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n * capacity) - About three times a single DP pass
+ * @complexity Space: O(capacity) - No (n+1) x (capacity+1) table
+ */
+Solution dynamicProgrammingLinear(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (n == 0 || capacity < 0) return result;
+
+    int minWeight = 0;
+    {
+        std::vector<int> row;
+        if (!knapsackProfile(instance, 0, n, capacity, row, token)) return result;
+        int maxProfit = row[capacity];
+        while (row[minWeight] != maxProfit) minWeight++;
+    }
+
+    Solution take(n);
+    if (!hirschbergReconstruct(instance, 0, n, minWeight, take, token)) return result;
+    return take;
+}
+
+// ====================================================================== //
+// ===================== BITSET DYNAMIC PROGRAMMING ===================== //
+// ====================================================================== //
+
+/**
+ * @struct DpScratch
+ * @brief DP buffers kept per thread between calls.
+ *
+ * Repeated solves on one thread (batch mode solves thousands of loads per
+ * worker) reuse the rows and the decision table instead of allocating
+ * them for every instance. The rows are untyped, so solves of every cell
+ * width share them. Decision tables above retainWords are freed after
+ * use, so one large instance does not pin its memory for good.
+ */
+struct DpScratch {
+    static const size_t retainWords = (size_t)1 << 22;  ///< 32 MB of decision bits
+
+    std::vector<uint64_t> took;
+    AlignedRow rowA{0}, rowB{0};
+
+    void release() {
+        if (took.capacity() > retainWords) std::vector<uint64_t>().swap(took);
+    }
+};
+
+/**
+ * @brief The calling thread's DP scratch buffers.
+ */
+DpScratch& threadScratch() {
+    thread_local DpScratch scratch;
+    return scratch;
+}
+
+/**
+ * @brief Runs solve with the narrowest DP cell type that holds every value of the instance.
+ *
+ * The Instance sums the positive profits when it is built, right after
+ * parsing, so the choice costs nothing here. Instances whose profits add
+ * up past 32 bits get 64-bit cells instead of overflowing.
+ *
+ * @param solve Generic callable invoked with a zero of the chosen type
+ */
+template <typename Solve>
+Solution withCellWidth(const Instance& instance, Solve solve) {
+    switch (knapsackValueBits(instance.profitCeiling())) {
+    case 16: return solve(uint16_t(0));
+    case 32: return solve(uint32_t(0));
+    default: return solve(uint64_t(0));
+    }
+}
+
+/**
+ * @brief Profit of pallet i as a DP cell value.
+ *
+ * A pallet that earns nothing never strictly improves a cell, so clamping
+ * negative profits to zero keeps the decisions and lets cells be unsigned.
+ */
+template <typename Value>
+Value cellProfit(const Instance& instance, int i) {
+    return (Value)std::max(0, instance.profit(i));
+}
+
+/**
+ * @brief Follows the decision bits back from the lightest optimal cell of the last row.
+ *
+ * A pallet is taken where its bit is set (dp[i][j] != dp[i-1][j]), which
+ * is the traceback rule of dynamicProgramming().
+ *
+ * @complexity Time: O(capacity + n)
+ */
+template <typename Value>
+Solution traceDecisions(const Instance& instance, const Value* row, const uint64_t* took, size_t words) {
+    int n = instance.size();
+    Solution result(n);
+    Value maxProfit = row[instance.capacity()];
+    int j = 0;
+    while (row[j] != maxProfit) j++;
+
+    for (int i = n - 1; i >= 0; i--) {
+        if ((took[i * words + (j >> 6)] >> (j & 63)) & 1) {
+            result.take(instance, i);
+            j -= instance.weight(i);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief In-place bitset DP over Value cells; see dynamicProgrammingBitset().
  */
-std::vector<Pallet> greedySolutionA(const std::vector<Pallet>& pallets, int capacity) {
-    int n = pallets.size();
-    std::vector<std::pair<Pallet, int>> items;
+template <typename Value>
+Solution bitsetKnapsack(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    size_t words = (size_t)capacity / 64 + 1;
+    DpScratch& scratch = threadScratch();
+    Value* row = scratch.rowA.reset<Value>(capacity + 1);
+    std::vector<uint64_t>& took = scratch.took;
+    took.assign(n * words, 0);
 
     for (int i = 0; i < n; i++) {
-        items.push_back({pallets[i], i});
+        if (stopRequested(token)) {
+            scratch.release();
+            return Solution(n);
+        }
+        int weight = instance.weight(i);
+        Value profit = cellProfit<Value>(instance, i);
+        uint64_t* bits = &took[i * words];
+        for (int j = capacity; j >= weight; j--) {
+            if (row[j - weight] + profit > row[j]) {
+                row[j] = row[j - weight] + profit;
+                bits[j >> 6] |= (uint64_t)1 << (j & 63);
+            }
+        }
     }
 
-    std::sort(items.begin(), items.end(), [](auto a, auto b){
-        return (double)a.first.profit / a.first.weight > (double)b.first.profit / b.first.weight;
+    Solution result = traceDecisions(instance, row, took.data(), words);
+    scratch.release();
+    return result;
+}
+
+/**
+ * @brief Solves 0/1 knapsack with a rolling value row and a 1-bit decision table.
+ *
+ * Instead of keeping every DP value, only the current row is stored, plus
+ * one bit per (pallet, capacity) cell recording whether taking the pallet
+ * improved that cell. All bits live in a single contiguous allocation.
+ * The traceback follows the same rule as dynamicProgramming()
+ * (dp[i][j] != dp[i-1][j]), so both return the same pallets. The row and
+ * the table live in the thread's DpScratch; the row holds 16, 32 or
+ * 64-bit cells, whichever is the narrowest that cannot overflow.
+ *
+ * @param instance Pallets and truck capacity
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n * capacity) - One pass plus an O(n) traceback
+ * @complexity Space: O(n * capacity / 64) words - 32x smaller than an int table
+ */
+Solution dynamicProgrammingBitset(const Instance& instance, const CancellationToken* token) {
+    if (instance.size() == 0 || instance.capacity() < 0) return Solution(instance.size());
+    return withCellWidth(instance, [&](auto zero) {
+        return bitsetKnapsack<decltype(zero)>(instance, token);
     });
+}
 
-    int currentWeight = 0;
-    std::vector<Pallet> result(pallets.size(), {0, 0});
+// ====================================================================== //
+// ====================== SIMD DYNAMIC PROGRAMMING ====================== //
+// ====================================================================== //
+
+/**
+ * @brief Two-row SIMD DP over Value cells; see dynamicProgrammingSIMD().
+ */
+template <typename Value>
+Solution simdKnapsack(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    KnapsackRowKernel<Value> kernel = bestKnapsackKernel<Value>().row;
+    size_t words = (size_t)capacity / 64 + 1;
+    DpScratch& scratch = threadScratch();
+    Value* prev = scratch.rowA.reset<Value>(capacity + 1);
+    Value* cur = scratch.rowB.reset<Value>(capacity + 1);
+    std::vector<uint64_t>& took = scratch.took;
+    took.assign(n * words, 0);
 
     for (int i = 0; i < n; i++) {
-        if (currentWeight + items[i].first.weight > capacity) break;
-        currentWeight += items[i].first.weight;
-        result[items[i].second] = items[i].first;
+        if (stopRequested(token)) {
+            scratch.release();
+            return Solution(n);
+        }
+        kernel(prev, cur, &took[i * words], 0, capacity, instance.weight(i), cellProfit<Value>(instance, i));
+        std::swap(prev, cur);
     }
 
+    Solution result = traceDecisions(instance, prev, took.data(), words);
+    scratch.release();
     return result;
 }
 
 /**
- * @brief Greedy heuristic using profit-first sorting.
- * 
- * Sorts pallets by descending profit (with weight tie-breaker),
- * selects items until capacity is full.
- * 
- * @param pallets Vector of pallet objects
- * @param capacity Truck weight limit
- * @return Subset of pallets selected by profit-first criteria
- * 
- * @complexity Time: O(n log n) - Sorting dominates complexity
- * @complexity Space: O(n) - Stores sorted items and result
+ * @brief Solves 0/1 knapsack with a vectorized row update.
+ *
+ * Keeps two aligned rows and computes each one from the previous with the
+ * fastest row kernel of the running CPU (AVX2, SSE4.1 or scalar, see
+ * kernels.h). Cells are 16, 32 or 64 bits wide, the narrowest that holds
+ * the sum of the profits, so small-profit instances fill twice as many
+ * lanes per instruction. Kernels emit the same decision bits as
+ * dynamicProgrammingBitset(), so the selected pallets are identical.
+ * Rows and decision bits are reused from the thread's DpScratch.
+ *
+ * @param instance Pallets and truck capacity
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n * capacity / lanes) - 16 lanes with AVX2 on 16-bit cells, 8 on 32-bit ones
+ * @complexity Space: O(capacity + n * capacity / 64) - Two rows and the decision bits
  */
-std::vector<Pallet> greedySolutionB(const std::vector<Pallet>& pallets, int capacity) {
-    int n = pallets.size();
-    std::vector<std::pair<Pallet, int>> items;
+Solution dynamicProgrammingSIMD(const Instance& instance, const CancellationToken* token) {
+    if (instance.size() == 0 || instance.capacity() < 0) return Solution(instance.size());
+    return withCellWidth(instance, [&](auto zero) {
+        return simdKnapsack<decltype(zero)>(instance, token);
+    });
+}
 
-    for (int i = 0; i < n; i++) {
-        items.push_back({pallets[i], i});
+// ====================================================================== //
+// ==================== PARALLEL DYNAMIC PROGRAMMING ==================== //
+// ====================================================================== //
+
+/**
+ * @brief Reusable barrier for a fixed group of DP worker threads.
+ *
+ * Workers spin briefly and then yield while waiting, which keeps the
+ * per-pallet synchronization cheap when every thread has its own core
+ * and still makes progress when threads outnumber cores.
+ */
+class RowBarrier {
+public:
+    explicit RowBarrier(int count) : count(count), waiting(0), generation(0) {}
+
+    void arriveAndWait() {
+        int gen = generation.load(std::memory_order_acquire);
+        if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            waiting.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        for (int spins = 0; generation.load(std::memory_order_acquire) == gen; spins++) {
+            if (spins >= 64) std::this_thread::yield();
+        }
     }
 
-    std::sort(items.begin(), items.end(), [](auto a, auto b){
-        if (a.first.profit == b.first.profit)
-            return a.first.weight < b.first.weight;
-        return a.first.profit > b.first.profit;
+private:
+    const int count;
+    std::atomic<int> waiting;
+    std::atomic<int> generation;
+};
+
+/**
+ * @brief Row-sliced multithreaded DP over Value cells; see dynamicProgrammingParallel().
+ */
+template <typename Value>
+Solution parallelKnapsack(const Instance& instance, int threads, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+
+    // Slices below a few thousand cells cost more in synchronization than they save
+    const int minWordsPerThread = 64;
+    int words = capacity / 64 + 1;
+    threads = std::max(1, std::min(threads, words / minWordsPerThread));
+    int wordsPerThread = (words + threads - 1) / threads;
+
+    KnapsackRowKernel<Value> kernel = bestKnapsackKernel<Value>().row;
+    AlignedRow rowA((capacity + 1) * sizeof(Value)), rowB((capacity + 1) * sizeof(Value));
+    std::vector<uint64_t> took((size_t)n * words, 0);
+    RowBarrier barrier(threads);
+    std::atomic<int> stopRow(n);
+
+    auto work = [&](int t) {
+        int first = t * wordsPerThread * 64;
+        int last = std::min(capacity, (t + 1) * wordsPerThread * 64 - 1);
+        Value* prev = rowA.data<Value>();
+        Value* cur = rowB.data<Value>();
+        for (int i = 0; i < n; i++) {
+            if (first <= last) {
+                kernel(prev, cur, &took[(size_t)i * words], first, last, instance.weight(i),
+                       cellProfit<Value>(instance, i));
+            }
+            if (t == 0 && stopRow.load(std::memory_order_relaxed) == n && stopRequested(token)) {
+                stopRow.store(i + 1, std::memory_order_relaxed);
+            }
+            barrier.arriveAndWait();
+            std::swap(prev, cur);
+            if (i + 1 >= stopRow.load(std::memory_order_relaxed)) break;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(work, t);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+    if (stopRow.load() < n) return Solution(n);
+
+    const Value* finalRow = (n % 2 == 0) ? rowA.data<Value>() : rowB.data<Value>();
+    return traceDecisions(instance, finalRow, took.data(), words);
+}
+
+/**
+ * @brief Solves 0/1 knapsack with the capacity axis split across threads.
+ *
+ * Row i of the DP only reads row i-1, so every thread owns a fixed slice
+ * of capacities (a multiple of 64 cells, so decision-bit words are never
+ * shared) and fills it with the SIMD row kernel. Threads meet at a
+ * barrier after each pallet before the rows are swapped. Cells have the
+ * width dynamicProgrammingSIMD() would pick. Decisions and traceback
+ * match dynamicProgrammingBitset(). Only thread 0 polls the token; it
+ * publishes the row to stop after before the barrier, so every thread
+ * leaves the loop at the same row.
+ *
+ * @param instance Pallets and truck capacity
+ * @param threads Number of threads to use (0 = all hardware threads)
+ * @param token Optional stop request, polled once per pallet
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n * capacity / (lanes * threads) + n * sync)
+ * @complexity Space: O(capacity + n * capacity / 64) - Two rows and the decision bits
+ */
+Solution dynamicProgrammingParallel(const Instance& instance, int threads, const CancellationToken* token) {
+    if (instance.size() == 0 || instance.capacity() < 0) return Solution(instance.size());
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return withCellWidth(instance, [&](auto zero) {
+        return parallelKnapsack<decltype(zero)>(instance, threads, token);
     });
+}
 
-    int currentWeight = 0;
-    std::vector<Pallet> result(pallets.size(), {0, 0});
+// ====================================================================== //
+// ===================== SPARSE DYNAMIC PROGRAMMING ===================== //
+// ====================================================================== //
 
-    for (int i = 0; i < n; i++) {
-        if (currentWeight + items[i].first.weight > capacity) break;
-        currentWeight += items[i].first.weight;
-        result[items[i].second] = items[i].first;
+/**
+ * @brief Fractional knapsack bound for the pallets order[k..n).
+ *
+ * Finds the break item with a binary search over the prefix sums and adds
+ * the rounded-down fraction of it that still fits.
+ *
+ * @param instance Pallets, with their ratio order and prefix sums
+ * @param k First position of the order still undecided
+ * @param remaining Capacity left for those pallets
+ * @return Upper bound on the profit they can add
+ *
+ * @complexity Time: O(log n)
+ * @complexity Space: O(1)
+ */
+long long dantzigBound(const Instance& instance, int k, long long remaining) {
+    const RatioPrefix& rp = instance.ratioPrefix();
+    int n = rp.positive;  // Pallets after these earn nothing
+    if (remaining < 0 || k >= n) return 0;
+    int t = std::upper_bound(rp.weight.begin() + k, rp.weight.begin() + n + 1, rp.weight[k] + remaining) -
+            rp.weight.begin() - 1;
+    long long bound = rp.profit[t] - rp.profit[k];
+    if (t < n) {
+        int breakItem = rp.order[t];
+        long long residual = remaining - (rp.weight[t] - rp.weight[k]);
+        bound += residual * instance.profit(breakItem) / instance.weight(breakItem);
+    }
+    return bound;
+}
+
+/**
+ * @brief Pareto-list DP over the positions [first, last) of the ratio order.
+ *
+ * Pallets are added in ratio order. After each pallet only the
+ * (weight, profit) states that no lighter state matches in profit are
+ * kept, in increasing weight, and states whose fractional bound cannot
+ * reach lowerBound (raised to the best profit seen so far) are dropped.
+ * Each kept state links to the state it extends, which is enough to
+ * rebuild the load.
+ *
+ * @param instance Pallets, with their ratio order and prefix sums
+ * @param first First position of the order to decide
+ * @param last One past the last position to decide
+ * @param capacity Capacity available to these pallets
+ * @param lowerBound Profit the answer has to reach to be of interest
+ * @param chosen Receives the pallets of the best load (appended)
+ * @param token Optional stop request, polled once per pallet
+ * @return False if no load reaches lowerBound or the run was stopped, true otherwise
+ *
+ * @complexity Time: O(m * S * log n) - m pallets, S is the largest state list kept
+ * @complexity Space: O(m * S) worst case for the back-links, O(S) for the lists
+ */
+bool paretoKnapsack(const Instance& instance, int first, int last, long long capacity, long long lowerBound,
+                    std::vector<int>& chosen, const CancellationToken* token) {
+    if (capacity < 0) return false;
+    const RatioPrefix& rp = instance.ratioPrefix();
+
+    struct State {
+        long long weight;
+        long long profit;
+        int link;   ///< Back-link into links, -1 for the empty load
+    };
+    struct Link {
+        int parent; ///< Previous back-link, -1 for the empty load
+        int pallet; ///< Pallet added by this step
+    };
+
+    std::vector<Link> links;
+    std::vector<State> states = {{0, 0, -1}}, merged;
+
+    for (int k = first; k < last && !states.empty(); k++) {
+        if (stopRequested(token)) return false;
+        int item = rp.order[k];
+        long long weight = instance.weight(item);
+        long long profit = instance.profit(item);
+
+        merged.clear();
+        size_t a = 0, b = 0;
+        long long lastProfit = -1;
+        while (true) {
+            // Skip extended states that no longer fit; states are sorted by weight
+            if (b < states.size() && states[b].weight + weight > capacity) b = states.size();
+            if (a == states.size() && b == states.size()) break;
+
+            State next;
+            bool extended;
+            if (b == states.size() ||
+                (a < states.size() && (states[a].weight < states[b].weight + weight ||
+                 (states[a].weight == states[b].weight + weight && states[a].profit >= states[b].profit + profit)))) {
+                next = states[a++];
+                extended = false;
+            } else {
+                next = {states[b].weight + weight, states[b].profit + profit, states[b].link};
+                b++;
+                extended = true;
+            }
+
+            if (next.profit <= lastProfit) continue;
+            if (next.profit + dantzigBound(instance, k + 1, capacity - next.weight) < lowerBound) continue;
+
+            if (extended) {
+                links.push_back({next.link, item});
+                next.link = links.size() - 1;
+            }
+            lowerBound = std::max(lowerBound, next.profit);
+            lastProfit = next.profit;
+            merged.push_back(next);
+        }
+        states.swap(merged);
+    }
+
+    if (states.empty() || states.back().profit < lowerBound) return false;
+    for (int link = states.back().link; link != -1; link = links[link].parent) {
+        chosen.push_back(links[link].pallet);
+    }
+    return true;
+}
+
+/**
+ * @brief Solves 0/1 knapsack by merging lists of non-dominated states.
+ *
+ * Runs paretoKnapsack() over all pallets with the greedy load as the
+ * initial lower bound. Runtime follows the number of useful states rather
+ * than the capacity and no capacity-sized array is allocated, so
+ * capacities in the billions are fine.
+ *
+ * @param instance Pallets and truck capacity
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n * S * log n) - S is the largest state list kept
+ * @complexity Space: O(n * S) worst case for the back-links, O(S) for the lists
+ */
+Solution sparseDynamicProgramming(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (n == 0 || capacity < 0) return result;
+
+    const RatioPrefix& rp = instance.ratioPrefix();
+
+    // Greedy lower bound for the pruning
+    long long lowerBound = 0, greedyWeight = 0;
+    for (int k = 0; k < n; k++) {
+        int item = rp.order[k];
+        if (greedyWeight + instance.weight(item) <= capacity) {
+            greedyWeight += instance.weight(item);
+            lowerBound += instance.profit(item);
+        }
     }
 
+    std::vector<int> chosen;
+    paretoKnapsack(instance, 0, n, capacity, lowerBound, chosen, token);
+    for (int item : chosen) result.take(instance, item);
+    return result;
+}
+
+// ====================================================================== //
+// ======================= APPROXIMATION ALGORITHM ====================== //
+// ====================================================================== //
+
+
+/**
+ * @brief Greedy heuristic along a given order.
+ *
+ * Takes pallets in order, skipping those that no longer fit. The load
+ * contains the prefix that stops at the first misfit, so it is never
+ * worse, and pallets tied in the order cannot cut it short.
+ *
+ * @param instance Pallets and truck capacity
+ * @param order Permutation of the pallet indices
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n)
+ * @complexity Space: O(n / 64) - The load
+ */
+Solution greedyAlong(const Instance& instance, const std::vector<int>& order) {
+    Solution result(instance.size());
+    for (int item : order) {
+        if (result.weight() + instance.weight(item) <= instance.capacity()) result.take(instance, item);
+    }
     return result;
 }
 
 /**
  * @brief Returns best of two greedy approximation approaches.
  * 
- * Combines results from ratio-based and profit-based greedy strategies,
- * returning the solution with higher total profit. Guarantees a 2-approximation.
+ * Combines results from ratio-based and profit-based greedy strategies
+ * (the instance's ratio order and profit order, sorted once), returning
+ * the solution with higher total profit. Guarantees a 2-approximation.
  * 
- * @param pallets Vector of pallet objects
- * @param capacity Truck weight limit
+ * @param instance Pallets and truck capacity
  * @return Better of two greedy solutions (A or B)
  * 
- * @complexity Time: O(n log n) - Two sorts and linear scans
- * @complexity Space: O(n) - Stores two solution vectors
+ * @complexity Time: O(n log n) - The two orders on first use, then linear scans
+ * @complexity Space: O(n / 64) - Two loads
+ */
+Solution approximationAlgorithm(const Instance& instance) {
+    Solution resultA = greedyAlong(instance, instance.ratioPrefix().order);
+    Solution resultB = greedyAlong(instance, instance.profitOrder());
+    bool aBetter = resultA.profit() > resultB.profit() ||
+                   (resultA.profit() == resultB.profit() && resultA.weight() < resultB.weight());
+    return aBetter ? resultA : resultB;
+}
+
+// ====================================================================== //
+// =============================== FPTAS ================================ //
+// ====================================================================== //
+
+/**
+ * @brief Minimum weight needed to reach each scaled profit with a range of pallets.
+ *
+ * After the call, row[q] holds the lightest weight of a subset of
+ * [first, last) whose scaled profit is at least q (LLONG_MAX if none).
+ * Returns false if the token stopped it first.
+ *
+ * @complexity Time: O((last - first) * target)
+ * @complexity Space: O(target)
+ */
+bool minWeightProfile(const Instance& items, const std::vector<int>& scaled,
+                      int first, int last, int target, std::vector<long long>& row,
+                      const CancellationToken* token) {
+    row.assign(target + 1, LLONG_MAX);
+    row[0] = 0;
+    for (int i = first; i < last; i++) {
+        if (stopRequested(token)) return false;
+        long long weight = items.weight(i);
+        for (int q = target; q > 0; q--) {
+            long long base = row[std::max(0, q - scaled[i])];
+            if (base != LLONG_MAX && base + weight < row[q]) row[q] = base + weight;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rebuilds the lightest subset reaching a scaled profit by divide and conquer.
+ *
+ * Same scheme as hirschbergReconstruct(), over profits instead of weights:
+ * each half gets the share of the target that minimizes the combined weight.
+ *
+ * @complexity Time: O((last - first) * target)
+ * @complexity Space: O(target + log n)
+ */
+bool fptasReconstruct(const Instance& items, const std::vector<int>& scaled,
+                      int first, int last, int target, Solution& take,
+                      const CancellationToken* token) {
+    if (target <= 0) return true;
+    if (last - first == 1) {
+        take.take(items, first);
+        return true;
+    }
+
+    int mid = first + (last - first) / 2;
+    int split = 0;
+    {
+        std::vector<long long> left, right;
+        if (!minWeightProfile(items, scaled, first, mid, target, left, token)) return false;
+        if (!minWeightProfile(items, scaled, mid, last, target, right, token)) return false;
+
+        long long best = LLONG_MAX;
+        for (int q = 0; q <= target; q++) {
+            if (left[q] == LLONG_MAX || right[target - q] == LLONG_MAX) continue;
+            if (left[q] + right[target - q] < best) {
+                best = left[q] + right[target - q];
+                split = q;
+            }
+        }
+    }
+
+    return fptasReconstruct(items, scaled, first, mid, split, take, token) &&
+           fptasReconstruct(items, scaled, mid, last, target - split, take, token);
+}
+
+/**
+ * @brief Fully polynomial-time approximation scheme for 0/1 knapsack.
+ *
+ * Profits are scaled down by K = epsilon * LB / m, where LB is the better of
+ * the greedy load and the best single pallet and m the number of pallets that
+ * fit. A DP over scaled profit then finds the lightest load for every scaled
+ * profit up to U / K, with U the Dantzig bound (U <= 2 * LB). Rounding loses
+ * at most K per pallet, so the load found is worth at least (1 - epsilon)
+ * times the optimum. Memory stays O(m / epsilon) because the load is rebuilt
+ * by divide and conquer instead of from a table. If the token stops the
+ * DP, the greedy load is returned and the bound falls back to Dantzig's.
+ *
+ * @param instance Pallets and truck capacity
+ * @param epsilon Allowed relative loss, in (0, 1)
+ * @param upperBound If not null, receives a proven bound on the optimal profit
+ * @param token Optional stop request
+ * @return Selected pallets
+ *
+ * @complexity Time: O(m^2 / epsilon)
+ * @complexity Space: O(m / epsilon)
  */
-std::vector<Pallet> approximationAlgorithm(const std::vector<Pallet>& pallets, int capacity) {
-    std::vector<Pallet> resultA = greedySolutionA(pallets, capacity);
-    std::vector<Pallet> resultB = greedySolutionB(pallets, capacity);
+Solution fptasApproximation(const Instance& instance, double epsilon, long long* upperBound,
+                            const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (upperBound) *upperBound = 0;
+    if (capacity < 0) return result;
+    epsilon = std::min(std::max(epsilon, 1e-6), 0.999);
+
+    // Only pallets that fit on their own and earn something matter
+    std::vector<int> weights, profits, index;
+    for (int i = 0; i < n; i++) {
+        if (instance.weight(i) <= capacity && instance.profit(i) > 0) {
+            weights.push_back(instance.weight(i));
+            profits.push_back(instance.profit(i));
+            index.push_back(i);
+        }
+    }
+    int m = index.size();
+    if (m == 0) return result;
+
+    Instance items(std::move(weights), std::move(profits), capacity);
+    const RatioPrefix& rp = items.ratioPrefix();
+    long long bound = dantzigBound(items, 0, capacity);
+
+    // Lower bound: greedy load or best single pallet, whichever is better
+    Solution take(m);
+    long long greedyWeight = 0;
+    for (int k = 0; k < m; k++) {
+        int item = rp.order[k];
+        if (greedyWeight + items.weight(item) <= capacity) {
+            greedyWeight += items.weight(item);
+            take.take(items, item);
+        }
+    }
+    int bestSingle = 0;
+    for (int i = 1; i < m; i++) {
+        if (items.profit(i) > items.profit(bestSingle)) bestSingle = i;
+    }
+    if (items.profit(bestSingle) > take.profit()) {
+        take = Solution(m);
+        take.take(items, bestSingle);
+    }
+    long long lowerBound = take.profit();
 
-    int profitA = 0, profitB = 0;
-    for (const Pallet& p : resultA) profitA += p.profit;
-    for (const Pallet& p : resultB) profitB += p.profit;
+    double scale = std::max(1.0, epsilon * lowerBound / m);
+    std::vector<int> scaled(m);
+    for (int i = 0; i < m; i++) scaled[i] = (int)(items.profit(i) / scale);
+    int target = (int)(bound / scale);
 
-    return (profitA > profitB) ? resultA : resultB;
+    std::vector<long long> row;
+    Solution scaledTake(m);
+    bool finished = minWeightProfile(items, scaled, 0, m, target, row, token);
+    if (finished) {
+        while (target > 0 && row[target] > capacity) target--;
+        finished = fptasReconstruct(items, scaled, 0, m, target, scaledTake, token);
+    }
+
+    if (finished && scaledTake.profit() >= lowerBound) {
+        lowerBound = scaledTake.profit();
+        take = scaledTake;
+    }
+
+    if (upperBound) {
+        *upperBound = finished ? std::min(bound, (long long)std::floor(lowerBound / (1 - epsilon))) : bound;
+    }
+    for (int i : take.indices()) result.take(instance, index[i]);
+    return result;
 }
 
 // ====================================================================== //
@@ -303,152 +1253,941 @@ std::vector<Pallet> approximationAlgorithm(const std::vector<Pallet>& pallets, i
  * @brief Computes upper bound via fractional knapsack relaxation.
  * 
  * Used in branch-and-bound to estimate maximum possible profit for
- * current partial solution through LP relaxation.
+ * current partial solution through LP relaxation. The prefix sums of the
+ * ratio order locate the first item that no longer fits in one binary
+ * search instead of a scan.
  * 
- * @param sortedPallets Items sorted by profit/weight ratio
- * @param startIndex Starting index for remaining items
+ * @param instance Pallets, with their ratio order and prefix sums
+ * @param startIndex Starting position in the ratio order
  * @param currentWeight Weight accumulated in current path
  * @param capacity Total truck capacity
  * @return Upper bound profit estimate (fractional items allowed)
  * 
- * @complexity Time: O(n) - Linear scan of remaining items
+ * @complexity Time: O(log n) - Binary search over the prefix sums
  * @complexity Space: O(1) - No additional storage
  */
-double lpBound(const std::vector<std::pair<Pallet, int>>& sortedPallets, int startIndex, long long currentWeight, int capacity) {
-    double remainingCapacity = capacity - currentWeight;
-    double bound = 0;
+double lpBound(const Instance& instance, int startIndex, long long currentWeight, int capacity) {
+    const RatioPrefix& rp = instance.ratioPrefix();
+    int n = rp.positive;  // Pallets after these earn nothing
+    if (startIndex >= n) return 0;
+    long long limit = rp.weight[startIndex] + (capacity - currentWeight);
+    int t = std::upper_bound(rp.weight.begin() + startIndex, rp.weight.begin() + n + 1, limit) - rp.weight.begin() - 1;
+    t = std::max(t, startIndex);  // an overfull path starts at the break item
 
-    for (int i = startIndex; i < (int)sortedPallets.size(); i++) {
-        int weight = sortedPallets[i].first.weight;
-        int profit = sortedPallets[i].first.profit;
-
-        if (weight > remainingCapacity) {
-            bound += profit * (remainingCapacity / weight);
-            break;
-        } else {
-            remainingCapacity -= weight;
-            bound += profit;
-        }
+    double bound = rp.profit[t] - rp.profit[startIndex];
+    if (t < n) {
+        int breakItem = rp.order[t];
+        double remainingCapacity = limit - rp.weight[t];
+        bound += instance.profit(breakItem) * (remainingCapacity / instance.weight(breakItem));
     }
-
     return bound;
 }
 
-/**
- * @brief Branch-and-bound search with profit/weight optimization.
- * 
- * Recursively explores item inclusion/exclusion while:
- * 1. Maintaining best known valid solution
- * 2. Pruning branches that cannot exceed current best profit
- * 3. Prioritizing items with higher profit/weight ratio
- * 
- * @param sortedPallets Items pre-sorted by profit/weight ratio
- * @param currentIndex Current position in item list
- * @param currentWeight Accumulated weight in current path
- * @param currentProfit Accumulated profit in current path
- * @param capacity Truck weight limit
- * @param currentTake Current selection status
- * @param bestTake Best found selection status
- * @param bestProfit Reference to best profit found
- * @param bestWeight Reference to best weight for optimal solutions
- * 
- * @complexity Time: O(2^n) - Exponential with pruning effectiveness
- * @complexity Space: O(n) - Recursion depth and tracking vectors
- */
-void branchAndBoundSearch(
-    const std::vector<std::pair<Pallet, int>>& sortedPallets,
-    int currentIndex,
-    long long currentWeight,
-    long long currentProfit,
-    int capacity,
-    std::vector<int>& currentTake,
-    std::vector<int>& bestTake,
-    long long& bestProfit,
-    long long& bestWeight
-) {
-    int n = sortedPallets.size();
-    if (currentIndex == n) {
-        if (currentProfit > bestProfit || (currentProfit == bestProfit && currentWeight < bestWeight)) {
-            bestProfit = currentProfit;
-            bestWeight = currentWeight;
-            bestTake = currentTake;
-        }
-        return;
-    }
-
-    double estimate = currentProfit + lpBound(sortedPallets, currentIndex, currentWeight, capacity);
-    if (estimate <= bestProfit) return;
-
-    Pallet pallet = sortedPallets[currentIndex].first;
-    if (currentWeight + pallet.weight <= capacity) {
-        currentTake[currentIndex] = 1;
-        branchAndBoundSearch(
-            sortedPallets, currentIndex + 1,
-            currentWeight + pallet.weight,
-            currentProfit + pallet.profit,
-            capacity, currentTake, bestTake,
-            bestProfit, bestWeight
-        );
-        currentTake[currentIndex] = 0;
-    }
-
-    branchAndBoundSearch(
-        sortedPallets, currentIndex + 1,
-        currentWeight, currentProfit,
-        capacity, currentTake, bestTake,
-        bestProfit, bestWeight
-    );
-}
-
 /**
  * @brief Solves 0/1 knapsack via branch-and-bound (ILP approach).
  * 
- * Uses profit/weight sorted items with LP relaxation for upper bounds,
- * initialized with greedy solution for effective pruning. Returns
+ * Walks the items in profit/weight order, inclusion first, and prunes
+ * every node whose LP relaxation bound cannot exceed the best profit.
+ * The greedy load seeds the incumbent for effective pruning. Returns
  * optimal subset with maximum profit and minimal weight when multiple
- * optima exist.
+ * optima exist. The search is iterative over a DepthFirstArena, so deep
+ * instances need no recursion and improvements copy n / 64 words.
  * 
- * @param pallets Vector of pallet objects
- * @param capacity Truck weight capacity
+ * @param instance Pallets and truck capacity
+ * @param token Optional stop request, polled every 4096 nodes; the best load so far is returned
+ * @param nodes If not null, receives the number of nodes expanded
  * @return Optimal pallet selection with profit/weight optimization
  * 
- * @complexity Time: O(2^n) - Worst case exponential, pruning reduces
- * @complexity Space: O(n) - Sorting and tracking structures
+ * @complexity Time: O(2^n * n) - Worst case exponential, pruning reduces
+ * @complexity Space: O(n) - Stack and two bitsets
  */
-std::vector<Pallet> integerLinearProgramming(const std::vector<Pallet>& pallets, int capacity) {
-    int n = pallets.size();
-    std::vector<std::pair<Pallet, int>> items;
-    for (int i = 0; i < n; ++i) {
-        items.push_back({pallets[i], i});
+Solution integerLinearProgramming(const Instance& instance, const CancellationToken* token, long long* nodes) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    const std::vector<int>& order = instance.ratioPrefix().order;
+
+    DepthFirstArena arena(n);
+    long long bestProfit = 0;
+    long long bestWeight = 0;
+
+    // Greedy initialization for better pruning
+    for (int k = 0; k < n; k++) {
+        int item = order[k];
+        bool fits = bestWeight + instance.weight(item) <= capacity;
+        if (fits) {
+            bestWeight += instance.weight(item);
+            bestProfit += instance.profit(item);
+        }
+        arena.mark(k, fits);
     }
+    arena.recordBest();
 
-    std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
-        return (double)a.first.profit / a.first.weight > (double)b.first.profit / b.first.weight;
-    });
+    long long steps = 0;
+    int level = 0;
+    long long weight = 0, profit = 0;
+    // Taking the next pallet in ratio order, when it fits, leaves the LP
+    // relaxation unchanged, so a node reached that way keeps its parent's bound
+    bool sameBound = false;
+    while (true) {
+        if ((++steps & 0xFFF) == 0 && stopRequested(token)) break;
+
+        if (level == n) {
+            if (profit > bestProfit || (profit == bestProfit && weight < bestWeight)) {
+                bestProfit = profit;
+                bestWeight = weight;
+                arena.recordBest();
+            }
+            if (!arena.pop(level, weight, profit)) break;
+            sameBound = false;
+            continue;
+        }
+
+        if (!sameBound && profit + lpBound(instance, level, weight, capacity) <= bestProfit) {
+            if (!arena.pop(level, weight, profit)) break;
+            continue;
+        }
+
+        int item = order[level];
+        sameBound = weight + instance.weight(item) <= capacity;
+        if (sameBound) {
+            arena.pushSibling(level, weight, profit);
+            weight += instance.weight(item);
+            profit += instance.profit(item);
+        }
+        arena.mark(level++, sameBound);
+    }
+    if (nodes) *nodes = steps;
+
+    Solution result(n);
+    for (int k = 0; k < n; ++k) {
+        if (arena.inBest(k)) result.take(instance, order[k]);
+    }
+    return result;
+}
+
+// ====================================================================== //
+// ===================== BEST-FIRST BRANCH AND BOUND ==================== //
+// ====================================================================== //
 
-    std::vector<int> currTake(n, 0), bestTake(n, 0);
+/**
+ * @brief Martello-Toth U2 upper bound for the pallets order[k..n).
+ *
+ * With t the break item (the first one that no longer fits), U0 keeps t
+ * out and fills the residual capacity at the ratio of item t+1, while U1
+ * forces t in and pays for the overflow at the ratio of item t-1. The
+ * bound is max(U0, U1), never weaker than the Dantzig bound. Prefix sums
+ * give the break item in O(log n).
+ *
+ * @param instance Pallets, with their ratio order and prefix sums
+ * @param k First position of the order still undecided
+ * @param remaining Capacity left for those pallets
+ * @return Upper bound on the profit they can add
+ *
+ * @complexity Time: O(log n)
+ * @complexity Space: O(1)
+ */
+long long martelloTothBound(const Instance& instance, int k, long long remaining) {
+    const RatioPrefix& rp = instance.ratioPrefix();
+    int n = rp.positive;  // Pallets after these earn nothing
+    if (remaining < 0 || k >= n) return 0;
+    int t = std::upper_bound(rp.weight.begin() + k, rp.weight.begin() + n + 1, rp.weight[k] + remaining) -
+            rp.weight.begin() - 1;
+    long long sumProfit = rp.profit[t] - rp.profit[k];
+    if (t == n) return sumProfit;
+
+    long long residual = remaining - (rp.weight[t] - rp.weight[k]);
+    int breakItem = rp.order[t];
+
+    // A weightless neighbour (ratio order puts them at the ends) has no
+    // ratio to price the residual or the overflow with, so its term is skipped
+    long long u0 = sumProfit;
+    if (t + 1 < n && instance.weight(rp.order[t + 1]) > 0) {
+        int next = rp.order[t + 1];
+        u0 += residual * instance.profit(next) / instance.weight(next);
+    }
+
+    long long u1 = u0;
+    if (t > k && instance.weight(rp.order[t - 1]) > 0) {
+        int prev = rp.order[t - 1];
+        long long overflow = instance.weight(breakItem) - residual;
+        u1 = sumProfit + instance.profit(breakItem) -
+             (overflow * instance.profit(prev) + instance.weight(prev) - 1) / instance.weight(prev);
+    }
+    return std::max(u0, u1);
+}
+
+/**
+ * @struct SearchLink
+ * @brief One taken pallet of a search path, linked to the rest of the path.
+ */
+struct SearchLink {
+    int parent;  ///< Previous link, -1 for the empty load
+    int pallet;  ///< Pallet taken at this step
+};
+
+/**
+ * @struct BranchContext
+ * @brief Shared state of a branch-and-bound run: instance, incumbent and path arena.
+ */
+struct BranchContext {
+    const Instance& instance;
+    const RatioPrefix& rp;
+    int capacity;
+    std::vector<SearchLink> links;
     long long bestProfit = 0;
-    long long bestWeight = LLONG_MAX;
+    long long bestWeight = 0;
+    int bestLink = -1;
+    const CancellationToken* token = nullptr;
+    long long steps = 0;     ///< Nodes visited, paces the token polls
+    bool stopped = false;    ///< Sticky once the token asked to stop
+    DepthFirstArena arena{0};  ///< Stack and path of the depth-first dives
+};
 
-    // Greedy initialization for better pruning
-    long long currentWeight = 0;
-    for (int i = 0; i < n; i++) {
-        const auto& pallet = items[i].first;
-        if (currentWeight + pallet.weight <= capacity) {
-            bestTake[i] = 1;
-            currentWeight += pallet.weight;
-            bestProfit += pallet.profit;
+/**
+ * @brief Polls the context token every 1024 nodes and remembers a stop.
+ */
+bool branchStopped(BranchContext& ctx) {
+    if (!ctx.stopped && (++ctx.steps & 1023) == 0) ctx.stopped = stopRequested(ctx.token);
+    return ctx.stopped;
+}
+
+/**
+ * @brief Least weight at which a completion of the node earns target profit in total.
+ *
+ * The weight needed to gain the missing profit is at least the missing
+ * profit divided by the best ratio left, which is the ratio of the next
+ * pallet in the order.
+ *
+ * @return That weight, or LLONG_MAX if no pallet left can add profit
+ * @complexity Time: O(1)
+ */
+long long minimumWeightFor(const Instance& instance, int level, long long weight, long long profit,
+                           long long target) {
+    long long missing = target - profit;
+    if (missing <= 0) return weight;
+    if (level == (int)instance.size()) return LLONG_MAX;
+
+    int next = instance.ratioPrefix().order[level];
+    long long nextWeight = instance.weight(next), nextProfit = instance.profit(next);
+    if (nextProfit <= 0) return LLONG_MAX;
+    return weight + (missing * nextWeight + nextProfit - 1) / nextProfit;
+}
+
+/**
+ * @brief Checks whether a node can still beat the incumbent.
+ *
+ * A node can improve when its bound exceeds the incumbent profit, or when
+ * it can match that profit with less weight (see minimumWeightFor()).
+ *
+ * @complexity Time: O(1)
+ */
+bool canImprove(const Instance& instance, long long bestProfit, long long bestWeight,
+                int level, long long weight, long long profit, long long bound) {
+    if (bound > bestProfit) return true;
+    if (bound < bestProfit) return false;
+    return minimumWeightFor(instance, level, weight, profit, bestProfit) < bestWeight;
+}
+
+bool canImprove(const BranchContext& ctx, int level, long long weight, long long profit, long long bound) {
+    return canImprove(ctx.instance, ctx.bestProfit, ctx.bestWeight, level, weight, profit, bound);
+}
+
+/**
+ * @brief Depth-first Martello-Toth branch and bound started from a known load.
+ *
+ * Walks the ratio order taking pallets first, like branchAndBound()'s
+ * dives, but with the given load as the first incumbent, so after a small
+ * change to the instance most of the tree is pruned by the first bounds.
+ * Pallets that earn nothing are never taken. The search is iterative over
+ * a DepthFirstArena: no recursion, and improvements copy n / 64 words.
+ *
+ * @param instance Pallets and truck capacity
+ * @param incumbent Feasible load to start from
+ * @param token Optional stop request, polled every 1024 nodes; the best load so far is returned
+ * @param finished If not null, set to false when the token stopped the search
+ * @return The best load found, at least as good as incumbent
+ *
+ * @complexity Time: O(2^n * log n) - Worst case, bounds prune most of it
+ * @complexity Space: O(n) - Stack and two bitsets
+ */
+Solution branchAndBoundFrom(const Instance& instance, const Solution& incumbent, const CancellationToken* token,
+                            bool* finished) {
+    int n = instance.size();
+    long long capacity = instance.capacity();
+    const RatioPrefix& rp = instance.ratioPrefix();
+
+    DepthFirstArena arena(n);
+    long long bestProfit = incumbent.profit(), bestWeight = incumbent.weight();
+    for (int k = 0; k < n; k++) arena.mark(k, incumbent.taken(rp.order[k]));
+    arena.recordBest();
+
+    long long steps = 0;
+    bool stopped = false;
+    int level = 0;
+    long long weight = 0, profit = 0;
+    while (true) {
+        if ((++steps & 1023) == 0 && stopRequested(token)) {
+            stopped = true;
+            break;
+        }
+        if (profit > bestProfit || (profit == bestProfit && weight < bestWeight)) {
+            bestProfit = profit;
+            bestWeight = weight;
+            arena.recordBest(level);
+        }
+
+        bool expand = level < n;
+        if (expand) {
+            long long bound = profit + martelloTothBound(instance, level, capacity - weight);
+            expand = canImprove(instance, bestProfit, bestWeight, level, weight, profit, bound);
+        }
+        if (!expand) {
+            if (!arena.pop(level, weight, profit)) break;
+            continue;
+        }
+
+        int item = rp.order[level];
+        bool take = weight + instance.weight(item) <= capacity && instance.profit(item) > 0;
+        if (take) {
+            arena.pushSibling(level, weight, profit);
+            weight += instance.weight(item);
+            profit += instance.profit(item);
+        }
+        arena.mark(level++, take);
+    }
+    if (finished) *finished = !stopped;
+
+    Solution result(n);
+    for (int k = 0; k < n; k++) {
+        if (arena.inBest(k)) result.take(instance, rp.order[k]);
+    }
+    return result;
+}
+
+/**
+ * @brief Depth-first branch and bound below a node, without storing nodes.
+ *
+ * The dive is iterative over the context arena, whose path bits record the
+ * pallets taken since the start level. They are only copied into the link
+ * arena when the path improves the incumbent.
+ *
+ * @param ctx Shared search state
+ * @param level Next position of the ratio order to decide
+ * @param weight Weight of the current path
+ * @param profit Profit of the current path
+ * @param baseLink Link of the node the depth-first dive started from
+ *
+ * @complexity Time: O(2^(n - level) * log n) - Worst case, bounds prune most of it
+ * @complexity Space: O(n) - The arena, allocated once per search
+ */
+void depthFirstBranch(BranchContext& ctx, int level, long long weight, long long profit, int baseLink) {
+    int n = ctx.rp.order.size();
+    int start = level;
+    DepthFirstArena& arena = ctx.arena;
+    arena.top = 0;
+    while (true) {
+        if (profit > ctx.bestProfit || (profit == ctx.bestProfit && weight < ctx.bestWeight)) {
+            ctx.bestProfit = profit;
+            ctx.bestWeight = weight;
+            int link = baseLink;
+            for (int k = start; k < level; k++) {
+                if (!arena.inPath(k)) continue;
+                ctx.links.push_back({link, ctx.rp.order[k]});
+                link = ctx.links.size() - 1;
+            }
+            ctx.bestLink = link;
+        }
+
+        bool expand = level < n;
+        if (expand) {
+            if (branchStopped(ctx)) return;
+            long long bound = profit + martelloTothBound(ctx.instance, level, ctx.capacity - weight);
+            expand = canImprove(ctx, level, weight, profit, bound);
+        }
+        if (!expand) {
+            if (!arena.pop(level, weight, profit)) return;
+            continue;
+        }
+
+        int item = ctx.rp.order[level];
+        bool take = weight + ctx.instance.weight(item) <= ctx.capacity;
+        if (take) {
+            arena.pushSibling(level, weight, profit);
+            weight += ctx.instance.weight(item);
+            profit += ctx.instance.profit(item);
+        }
+        arena.mark(level++, take);
+    }
+}
+
+/**
+ * @brief Solves 0/1 knapsack by branch and bound with Martello-Toth bounds.
+ *
+ * Pallets are sorted once by profit/weight with prefix sums, so every
+ * bound costs one binary search. The incumbent starts from the greedy
+ * load. In best-first mode open nodes wait in a priority queue ordered by
+ * bound, and each keeps its path as a link into a shared arena. Once the
+ * queue and arena hold maxNodes entries, new children are searched
+ * depth-first in place instead, so memory stays capped. Among optimal
+ * loads the lightest one is returned.
+ *
+ * @param instance Pallets and truck capacity
+ * @param bestFirst Use the node queue (true) or a plain depth-first search (false)
+ * @param maxNodes Cap on queued nodes plus stored path links in best-first mode
+ * @param token Optional stop request; the incumbent is returned
+ * @param nodes If not null, receives the number of nodes expanded
+ * @return Selected pallets
+ *
+ * @complexity Time: O(2^n * log n) - Worst case, bounds prune most of it
+ * @complexity Space: O(maxNodes + n)
+ */
+Solution branchAndBound(const Instance& instance, bool bestFirst, size_t maxNodes, const CancellationToken* token,
+                        long long* nodes) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (capacity < 0) return result;
+
+    const RatioPrefix& rp = instance.ratioPrefix();
+    BranchContext ctx{instance, rp, capacity, {}};
+    ctx.token = token;
+    ctx.arena = DepthFirstArena(n);
+
+    // Greedy incumbent along the ratio order
+    for (int k = 0; k < n; k++) {
+        int item = rp.order[k];
+        if (ctx.bestWeight + instance.weight(item) <= capacity) {
+            ctx.bestWeight += instance.weight(item);
+            ctx.bestProfit += instance.profit(item);
+            ctx.links.push_back({ctx.bestLink, item});
+            ctx.bestLink = ctx.links.size() - 1;
+        }
+    }
+
+    if (!bestFirst) {
+        depthFirstBranch(ctx, 0, 0, 0, -1);
+    } else {
+        struct BranchNode {
+            long long bound;
+            long long weight;
+            long long profit;
+            int level;
+            int link;
+        };
+        auto lowerPriority = [](const BranchNode& a, const BranchNode& b) {
+            if (a.bound != b.bound) return a.bound < b.bound;
+            return a.level < b.level;
+        };
+        std::priority_queue<BranchNode, std::vector<BranchNode>, decltype(lowerPriority)> open(lowerPriority);
+
+        auto push = [&](int level, long long weight, long long profit, int link) {
+            if (profit > ctx.bestProfit || (profit == ctx.bestProfit && weight < ctx.bestWeight)) {
+                ctx.bestProfit = profit;
+                ctx.bestWeight = weight;
+                ctx.bestLink = link;
+            }
+            if (level == n) return;
+            long long bound = profit + martelloTothBound(instance, level, capacity - weight);
+            if (!canImprove(ctx, level, weight, profit, bound)) return;
+
+            if (open.size() + ctx.links.size() < maxNodes) {
+                open.push({bound, weight, profit, level, link});
+            } else {
+                depthFirstBranch(ctx, level, weight, profit, link);
+            }
+        };
+
+        push(0, 0, 0, -1);
+        while (!open.empty() && !branchStopped(ctx)) {
+            BranchNode node = open.top();
+            open.pop();
+            if (node.bound < ctx.bestProfit) break;
+            if (!canImprove(ctx, node.level, node.weight, node.profit, node.bound)) continue;
+
+            // The inclusion link would pass the cap: search the node depth-first in place
+            if (open.size() + ctx.links.size() >= maxNodes) {
+                depthFirstBranch(ctx, node.level, node.weight, node.profit, node.link);
+                continue;
+            }
+
+            int item = rp.order[node.level];
+            int itemWeight = instance.weight(item);
+            if (node.weight + itemWeight <= capacity) {
+                ctx.links.push_back({node.link, item});
+                push(node.level + 1, node.weight + itemWeight, node.profit + instance.profit(item), ctx.links.size() - 1);
+            }
+            push(node.level + 1, node.weight, node.profit, node.link);
         }
     }
-    bestWeight = currentWeight;
 
-    branchAndBoundSearch(items, 0, 0, 0, capacity, currTake, bestTake, bestProfit, bestWeight);
+    for (int link = ctx.bestLink; link != -1; link = ctx.links[link].parent) {
+        result.take(instance, ctx.links[link].pallet);
+    }
+    if (nodes) *nodes = ctx.steps;
+    return result;
+}
+
+// ====================================================================== //
+// ==================== PARALLEL BRANCH AND BOUND ======================= //
+// ====================================================================== //
 
-    std::vector<Pallet> result(n);
-    for (int i = 0; i < n; ++i) {
-        if (bestTake[i]) {
-            result[items[i].second] = items[i].first;
+/**
+ * @brief Position of the first ratio-order position below limit taken by exactly one path.
+ *
+ * Paths are bitsets over ratio-order positions.
+ *
+ * @return The position, or -1 if both paths agree on [0, limit)
+ * @complexity Time: O(limit / 64)
+ */
+int firstDifference(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, int limit) {
+    for (int word = 0; word * 64 < limit; word++) {
+        uint64_t diff = a[word] ^ b[word];
+        if (word * 64 + 64 > limit) diff &= ((uint64_t)1 << (limit - word * 64)) - 1;
+        if (diff) return word * 64 + __builtin_ctzll(diff);
+    }
+    return -1;
+}
+
+/**
+ * @brief True if the path takes a position after q.
+ * @complexity Time: O(n / 64)
+ */
+bool takesAfter(const std::vector<uint64_t>& path, int q) {
+    uint64_t above = path[q >> 6] & ~((((uint64_t)1 << (q & 63)) << 1) - 1);
+    if (above) return true;
+    for (size_t word = (q >> 6) + 1; word < path.size(); word++) {
+        if (path[word]) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief True if take-first depth-first search in ratio order reaches load a before load b.
+ *
+ * That is the lexicographic order of the sorted position lists: at the
+ * first position only one load takes, that load comes first unless the
+ * other one stops there (a prefix comes before its extensions).
+ *
+ * @complexity Time: O(n / 64)
+ */
+bool reachedBefore(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    int q = firstDifference(a, b, (int)a.size() * 64);
+    if (q < 0) return false;
+    bool aTakes = (a[q >> 6] >> (q & 63)) & 1;
+    return aTakes ? takesAfter(b, q) : !takesAfter(a, q);
+}
+
+/**
+ * @struct SharedIncumbent
+ * @brief Best load found by any worker of a parallel search.
+ *
+ * Loads are ranked by profit, then by lower weight, then by which one
+ * take-first depth-first search reaches first. That ranking is total, so
+ * the final incumbent is the same for any thread count and any timing.
+ * Profit and weight are mirrored in atomics: offers and prunes that
+ * cannot matter are rejected without the lock, which is only taken for
+ * a real improvement or an exact (profit, weight) tie. The incumbent is
+ * kept as a bitset over ratio-order positions.
+ */
+struct SharedIncumbent {
+    std::atomic<long long> profit{0};
+    std::atomic<long long> weight{0};
+    std::vector<uint64_t> positions;  ///< Ratio-order positions of the incumbent load
+    std::vector<uint64_t> candidate;  ///< Scratch for an offered path, swapped in on success
+    std::mutex mutex;
+
+    // The incumbent only ever improves, and weight is stored before profit.
+    // A profit read followed by a weight read therefore sees a state at
+    // least as good as that profit, which makes both lock-free rejections
+    // safe. Bits of path from length on are ignored.
+    void offer(long long newProfit, long long newWeight, const std::vector<uint64_t>& path, int length) {
+        long long bestProfit = profit.load(std::memory_order_acquire);
+        if (newProfit < bestProfit) return;
+        if (newProfit == bestProfit && newWeight > weight.load(std::memory_order_acquire)) return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        long long currentProfit = profit.load(std::memory_order_relaxed);
+        long long currentWeight = weight.load(std::memory_order_relaxed);
+        if (newProfit < currentProfit || (newProfit == currentProfit && newWeight > currentWeight)) return;
+        candidate.assign(path.begin(), path.end());
+        DepthFirstArena::clearFrom(candidate, length);
+        if (newProfit == currentProfit && newWeight == currentWeight && !reachedBefore(candidate, positions)) return;
+        positions.swap(candidate);
+        weight.store(newWeight, std::memory_order_relaxed);
+        profit.store(newProfit, std::memory_order_release);
+    }
+
+    /**
+     * @brief True if some completion of the node may still outrank the incumbent.
+     *
+     * @param path Positions the node takes below level; later bits are ignored
+     * @param bound Upper bound on the profit of any completion
+     */
+    bool mayImprove(const Instance& instance, int level, long long weight, long long profit, long long bound,
+                    const std::vector<uint64_t>& path) {
+        long long bestProfit = this->profit.load(std::memory_order_acquire);
+        if (bound != bestProfit) return bound > bestProfit;
+        long long reach = minimumWeightFor(instance, level, weight, profit, bestProfit);
+        long long bestWeight = this->weight.load(std::memory_order_acquire);
+        if (reach != bestWeight) return reach < bestWeight;
+
+        // Exact tie: only paths that agree with the incumbent so far, or
+        // branch off it by taking a position it skips, can be reached first.
+        // A path that skips a position the incumbent takes only ties with
+        // itself, which was offered when its last pallet was taken.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (this->profit.load(std::memory_order_relaxed) != bestProfit ||
+            this->weight.load(std::memory_order_relaxed) != bestWeight) {
+            return false;  // the incumbent improved past this tie meanwhile
+        }
+        int q = firstDifference(path, positions, level);
+        if (q < 0) return true;
+        return ((path[q >> 6] >> (q & 63)) & 1) && takesAfter(positions, q);
+    }
+};
+
+/**
+ * @struct ParallelBranchContext
+ * @brief Read-only instance data plus the shared incumbent of a parallel search.
+ */
+struct ParallelBranchContext {
+    const Instance& instance;
+    const RatioPrefix& rp;
+    int capacity;
+    int spawnDepth;
+    WorkStealingPool& pool;
+    SharedIncumbent incumbent;
+    const CancellationToken* token = nullptr;
+    std::atomic<bool> stopped{false};  ///< Set by the first worker that sees the stop request
+};
+
+/**
+ * @brief Depth-first search task of the parallel branch and bound.
+ *
+ * Above spawnDepth the exclusion branch is handed to the pool as a new task
+ * while the current worker dives into the inclusion branch; deeper levels
+ * are searched in place, iteratively over a DepthFirstArena owned by the
+ * task. Every worker prunes against the shared incumbent. prefix holds the
+ * ratio-order positions taken above level; spawned tasks get a copy of the
+ * path. Loads only change when a pallet is taken, so only inclusions are
+ * offered to the incumbent.
+ *
+ * @complexity Time: O(2^(n - level) * log n) - Worst case, bounds prune most of it
+ * @complexity Space: O(n) - The task arena, plus n / 64 words per spawned task
+ */
+void parallelBranch(ParallelBranchContext& ctx, int level, long long weight, long long profit,
+                    const std::vector<uint64_t>& prefix) {
+    int n = ctx.rp.order.size();
+    DepthFirstArena arena(n);
+    std::copy(prefix.begin(), prefix.end(), arena.path.begin());
+
+    long long steps = 0;  // Nodes of this task, paces the token polls
+    while (true) {
+        bool expand = level < n;
+        if (expand) {
+            if (ctx.stopped.load(std::memory_order_relaxed)) return;
+            if ((++steps & 1023) == 0 && stopRequested(ctx.token)) {
+                ctx.stopped.store(true, std::memory_order_relaxed);
+                return;
+            }
+            long long bound = profit + martelloTothBound(ctx.instance, level, ctx.capacity - weight);
+            expand = ctx.incumbent.mayImprove(ctx.instance, level, weight, profit, bound, arena.path);
+        }
+        if (!expand) {
+            if (!arena.pop(level, weight, profit)) return;
+            continue;
+        }
+
+        int item = ctx.rp.order[level];
+        bool take = weight + ctx.instance.weight(item) <= ctx.capacity;
+        if (level < ctx.spawnDepth) {
+            arena.mark(level, false);
+            ctx.pool.submit([&ctx, level, weight, profit, path = arena.path] {
+                parallelBranch(ctx, level + 1, weight, profit, path);
+            });
+            if (!take) {
+                if (!arena.pop(level, weight, profit)) return;
+                continue;
+            }
+        } else if (take) {
+            arena.pushSibling(level, weight, profit);
+        }
+        if (take) {
+            weight += ctx.instance.weight(item);
+            profit += ctx.instance.profit(item);
         }
+        arena.mark(level++, take);
+        if (take) ctx.incumbent.offer(profit, weight, arena.path, level);
     }
+}
+
+/**
+ * @brief Solves 0/1 knapsack by branch and bound on a work-stealing pool.
+ *
+ * The search tree in ratio order is split into tasks near the root, and
+ * idle workers steal them. All workers prune against one shared incumbent
+ * seeded with the greedy load, using the Martello-Toth bound. The
+ * incumbent breaks profit and weight ties by search order, so the result
+ * is the load serial take-first search would pick, for any thread count.
+ * A stopped search returns the incumbent as it stands.
+ *
+ * @param instance Pallets and truck capacity
+ * @param threads Number of threads to use (0 = all hardware threads)
+ * @param token Optional stop request
+ * @return Selected pallets
+ *
+ * @complexity Time: O(2^n * log n / threads) - Worst case, bounds prune most of it
+ * @complexity Space: O(n * tasks) - Each live task holds an arena
+ */
+Solution parallelBranchAndBound(const Instance& instance, int threads, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (capacity < 0) return result;
+
+    const RatioPrefix& rp = instance.ratioPrefix();
+    WorkStealingPool pool(threads);
+
+    // About 2^spawnDepth tasks, enough for every worker to find something to steal
+    int spawnDepth = 4;
+    while ((1 << spawnDepth) < 16 * pool.size() && spawnDepth < 20) spawnDepth++;
+
+    ParallelBranchContext ctx{instance, rp, capacity, std::min(spawnDepth, n), pool, {}};
+    ctx.token = token;
+
+    std::vector<uint64_t> greedyPath(n / 64 + 1, 0);  // Sized like DepthFirstArena::path
+    long long greedyWeight = 0, greedyProfit = 0;
+    for (int k = 0; k < n; k++) {
+        int item = rp.order[k];
+        if (greedyWeight + instance.weight(item) <= capacity) {
+            greedyWeight += instance.weight(item);
+            greedyProfit += instance.profit(item);
+            greedyPath[k >> 6] |= (uint64_t)1 << (k & 63);
+        }
+    }
+    ctx.incumbent.positions.assign(greedyPath.size(), 0);
+    ctx.incumbent.offer(greedyProfit, greedyWeight, greedyPath, n);
+
+    pool.submit([&ctx, &greedyPath] {
+        parallelBranch(ctx, 0, 0, 0, std::vector<uint64_t>(greedyPath.size(), 0));
+    });
+    pool.wait();
+
+    const std::vector<uint64_t>& best = ctx.incumbent.positions;
+    for (int k = 0; k < n; k++) {
+        if ((best[k >> 6] >> (k & 63)) & 1) result.take(instance, rp.order[k]);
+    }
+    return result;
+}
+
+// ====================================================================== //
+// ============================ CORE PROBLEM ============================ //
+// ====================================================================== //
+
+/**
+ * @brief Solves 0/1 knapsack exactly through an expanding core around the break item.
+ *
+ * In the ratio order the LP relaxation takes every pallet before the break
+ * item and none after it, and optimal loads rarely stray far from it.
+ * Pallets outside a small window (the core) around the break item are
+ * fixed to their LP value, and the core is solved exactly with
+ * paretoKnapsack(). For each fixed pallet the reduced cost
+ * |p_j - r * w_j|, with r the break item ratio, bounds what any load
+ * flipping it can earn: at most U_LP - |p_j - r * w_j|. When no fixed
+ * pallet can reach the incumbent that way, the incumbent is optimal.
+ * Otherwise the core is widened to cover those pallets and solved again.
+ * Ties on profit also widen the core, so the lightest optimal load is returned.
+ *
+ * @param instance Pallets and truck capacity
+ * @param token Optional stop request; the incumbent is returned
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n log n + core DP) - Sorting plus usually small core solves
+ * @complexity Space: O(n + core DP states)
+ */
+Solution coreProblemSolver(const Instance& instance, const CancellationToken* token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    Solution result(n);
+    if (n == 0 || capacity < 0) return result;
+
+    const RatioPrefix& rp = instance.ratioPrefix();
+    int breakPos = std::upper_bound(rp.weight.begin(), rp.weight.end(), (long long)capacity) - rp.weight.begin() - 1;
+
+    // Everything fits: take every pallet that earns something
+    if (breakPos == n) {
+        for (int i = 0; i < n; i++) {
+            if (instance.profit(i) > 0) result.take(instance, i);
+        }
+        return result;
+    }
+
+    double ratio = instance.ratio(rp.order[breakPos]);
+    double lpBoundValue = rp.profit[breakPos] + (capacity - rp.weight[breakPos]) * ratio;
+    double slack = 1e-9 * std::max(1.0, lpBoundValue);
+
+    // Incumbent: greedy along the ratio order
+    std::vector<int> bestLoad;
+    long long bestProfit = 0, bestWeight = 0;
+    for (int k = 0; k < n; k++) {
+        int item = rp.order[k];
+        if (bestWeight + instance.weight(item) <= capacity) {
+            bestWeight += instance.weight(item);
+            bestProfit += instance.profit(item);
+            bestLoad.push_back(item);
+        }
+    }
+
+    int delta = 16;
+    int first = std::max(0, breakPos - delta);
+    int last = std::min(n, breakPos + delta + 1);
+
+    while (true) {
+        long long fixedWeight = rp.weight[first];
+        long long fixedProfit = rp.profit[first];
+
+        std::vector<int> core;
+        if (paretoKnapsack(instance, first, last, capacity - fixedWeight, bestProfit - fixedProfit, core, token)) {
+            long long profit = fixedProfit, weight = fixedWeight;
+            for (int item : core) {
+                profit += instance.profit(item);
+                weight += instance.weight(item);
+            }
+            if (profit > bestProfit || (profit == bestProfit && weight < bestWeight)) {
+                bestProfit = profit;
+                bestWeight = weight;
+                bestLoad.assign(rp.order.begin(), rp.order.begin() + first);
+                bestLoad.insert(bestLoad.end(), core.begin(), core.end());
+            }
+        }
+        if (stopRequested(token)) break;
+
+        // Fixed pallets whose flip could still reach the incumbent
+        int needFirst = first, needLast = last;
+        for (int k = 0; k < n; k++) {
+            if (k == first) k = last;
+            if (k >= n) break;
+            int item = rp.order[k];
+            double reducedCost = std::abs(instance.profit(item) - ratio * instance.weight(item));
+            if (lpBoundValue - reducedCost + slack >= bestProfit) {
+                needFirst = std::min(needFirst, k);
+                needLast = std::max(needLast, k + 1);
+            }
+        }
+        if (needFirst == first && needLast == last) break;
+
+        // Widen at least geometrically so the number of rounds stays logarithmic
+        delta *= 2;
+        first = std::min(needFirst, std::max(0, breakPos - delta));
+        last = std::max(needLast, std::min(n, breakPos + delta + 1));
+    }
+
+    for (int item : bestLoad) result.take(instance, item);
     return result;
-}
\ No newline at end of file
+}
+
+// ====================================================================== //
+// =========================== ANYTIME SEARCH =========================== //
+// ====================================================================== //
+
+/**
+ * @brief Branch and bound that can be stopped at any time with a usable answer.
+ *
+ * Starts from the greedy load (the same seed as integerLinearProgramming())
+ * and improves it with a depth-first search in ratio order, pruned with the
+ * Martello-Toth bound. Open nodes sit on an explicit stack with their
+ * bounds, and the current path is kept as per-level flags. The stop
+ * condition is checked every 1024 nodes. When it fires, the incumbent is
+ * returned together with the largest bound still open, which caps every
+ * load the search did not reach. If the search finishes, the load is
+ * optimal and the lightest among optimal loads.
+ *
+ * @param instance Pallets and truck capacity
+ * @param deadline Time at which the best load so far must be returned
+ * @param token Cancellation token, also honoured (including its own deadline)
+ * @return Best load found, its totals, upper bound and gap
+ *
+ * @complexity Time: O(min(2^n * log n, time budget))
+ * @complexity Space: O(n) - Stack holds at most two nodes per level
+ */
+AnytimeResult anytimeSolve(const Instance& instance, std::chrono::steady_clock::time_point deadline,
+                           const CancellationToken& token) {
+    int n = instance.size();
+    int capacity = instance.capacity();
+    AnytimeResult answer{Solution(n), 0, 0.0, true, 0};
+    if (capacity < 0) return answer;
+
+    const RatioPrefix& rp = instance.ratioPrefix();
+
+    // Greedy seed, flags indexed by ratio position
+    std::vector<char> best(n, 0), path(n, 0);
+    long long bestProfit = 0, bestWeight = 0;
+    for (int k = 0; k < n; k++) {
+        int item = rp.order[k];
+        if (bestWeight + instance.weight(item) <= capacity) {
+            bestWeight += instance.weight(item);
+            bestProfit += instance.profit(item);
+            best[k] = 1;
+        }
+    }
+
+    struct OpenNode {
+        long long bound;
+        long long weight;
+        long long profit;
+        int level;
+        char took;  ///< Whether the pallet at level - 1 is in the path
+    };
+    std::vector<OpenNode> stack;
+    stack.reserve(2 * n + 2);
+
+    long long rootBound = martelloTothBound(instance, 0, capacity);
+    stack.push_back({rootBound, 0, 0, 0, 0});
+
+    long long expanded = 0;
+    bool stopped = false;
+    while (!stack.empty()) {
+        if ((++expanded & 1023) == 0 &&
+            (token.stopRequested() || std::chrono::steady_clock::now() >= deadline)) {
+            stopped = true;
+            break;
+        }
+
+        OpenNode node = stack.back();
+        stack.pop_back();
+        if (node.level > 0) path[node.level - 1] = node.took;
+
+        if (node.profit > bestProfit || (node.profit == bestProfit && node.weight < bestWeight)) {
+            bestProfit = node.profit;
+            bestWeight = node.weight;
+            std::copy(path.begin(), path.begin() + node.level, best.begin());
+            std::fill(best.begin() + node.level, best.end(), 0);
+        }
+        if (node.level == n) continue;
+        if (!canImprove(instance, bestProfit, bestWeight, node.level, node.weight, node.profit, node.bound)) continue;
+
+        int item = rp.order[node.level];
+        long long itemWeight = instance.weight(item), itemProfit = instance.profit(item);
+        long long skipBound = node.profit + martelloTothBound(instance, node.level + 1, capacity - node.weight);
+        stack.push_back({skipBound, node.weight, node.profit, node.level + 1, 0});
+        if (node.weight + itemWeight <= capacity) {
+            long long takeBound = node.profit + itemProfit +
+                martelloTothBound(instance, node.level + 1, capacity - node.weight - itemWeight);
+            stack.push_back({takeBound, node.weight + itemWeight, node.profit + itemProfit, node.level + 1, 1});
+        }
+    }
+
+    long long upperBound = bestProfit;
+    if (stopped) {
+        for (const OpenNode& node : stack) upperBound = std::max(upperBound, node.bound);
+    }
+
+    for (int k = 0; k < n; k++) {
+        if (best[k]) answer.solution.take(instance, rp.order[k]);
+    }
+    answer.upperBound = std::min(upperBound, std::max(rootBound, bestProfit));
+    answer.gap = answer.upperBound > 0 ? (double)(answer.upperBound - bestProfit) / answer.upperBound : 0.0;
+    answer.optimal = !stopped;
+    answer.nodes = expanded;
+    return answer;
+}
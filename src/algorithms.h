@@ -1,8 +1,54 @@
+#ifndef ALGORITHMS_H
+#define ALGORITHMS_H
+
+#include <chrono>
+#include <cstddef>
 #include <vector>
-#include "pallet.h"
+#include "cancellation.h"
+#include "instance.h"
+
+/**
+ * @struct AnytimeResult
+ * @brief Best load found before a deadline, with a proven bound on the optimum.
+ */
+struct AnytimeResult {
+    Solution solution;            ///< Selected pallets with their totals
+    long long upperBound;         ///< No load can earn more than this
+    double gap;                   ///< (upperBound - profit) / upperBound
+    bool optimal;                 ///< True if the search finished before the deadline
+    long long nodes;              ///< Search nodes expanded
+};
+
+// Bound helpers shared with the fleet solver and the packing session
+long long martelloTothBound(const Instance& instance, int k, long long remaining);
+bool canImprove(const Instance& instance, long long bestProfit, long long bestWeight,
+                int level, long long weight, long long profit, long long bound);
+Solution branchAndBoundFrom(const Instance& instance, const Solution& incumbent,
+                            const CancellationToken* token = nullptr, bool* finished = nullptr);
+
+// Solvers taking a CancellationToken poll it while they run. Once it asks to
+// stop they return promptly: search-based solvers with their best load so
+// far, table-based ones with an empty load. Pass nullptr to run to completion.
+// Search engines taking a nodes pointer report the nodes they expanded there.
+Solution exhaustiveSearch(const Instance& instance, int threads = 0, const CancellationToken* token = nullptr);
+Solution meetInTheMiddle(const Instance& instance, const CancellationToken* token = nullptr);
+Solution backtracking(const Instance& instance, const CancellationToken* token = nullptr, long long* nodes = nullptr);
+Solution dynamicProgramming(const Instance& instance, const CancellationToken* token = nullptr);
+Solution dynamicProgrammingLinear(const Instance& instance, const CancellationToken* token = nullptr);
+Solution dynamicProgrammingBitset(const Instance& instance, const CancellationToken* token = nullptr);
+Solution dynamicProgrammingSIMD(const Instance& instance, const CancellationToken* token = nullptr);
+Solution dynamicProgrammingParallel(const Instance& instance, int threads = 0, const CancellationToken* token = nullptr);
+Solution sparseDynamicProgramming(const Instance& instance, const CancellationToken* token = nullptr);
+Solution approximationAlgorithm(const Instance& instance);
+Solution fptasApproximation(const Instance& instance, double epsilon = 0.1, long long* upperBound = nullptr,
+                            const CancellationToken* token = nullptr);
+Solution integerLinearProgramming(const Instance& instance, const CancellationToken* token = nullptr,
+                                  long long* nodes = nullptr);
+Solution branchAndBound(const Instance& instance, bool bestFirst = true, size_t maxNodes = 1 << 22,
+                        const CancellationToken* token = nullptr, long long* nodes = nullptr);
+Solution parallelBranchAndBound(const Instance& instance, int threads = 0, const CancellationToken* token = nullptr);
+Solution coreProblemSolver(const Instance& instance, const CancellationToken* token = nullptr);
+AnytimeResult anytimeSolve(const Instance& instance, std::chrono::steady_clock::time_point deadline,
+                           const CancellationToken& token);
 
-std::vector<Pallet> exhaustiveSearch(const std::vector<Pallet>& pallets, int capacity);
-std::vector<Pallet> backtracking(const std::vector<Pallet>& pallets, int capacity);
-std::vector<Pallet> dynamicProgramming(const std::vector<Pallet>& pallets, int capacity);
-std::vector<Pallet> approximationAlgorithm(const std::vector<Pallet>& pallets, int capacity);
-std::vector<Pallet> integerLinearProgramming(const std::vector<Pallet>& pallets, int capacity);
+#endif // ALGORITHMS_H
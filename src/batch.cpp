@@ -0,0 +1,146 @@
+/**
+ * @file batch.cpp
+ * @brief Manifest parsing and the concurrent batch runner.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include "batch.h"
+#include "binary.h"
+#include "parser.h"
+#include "threadpool.h"
+
+namespace fs = std::filesystem;
+
+std::vector<BatchJob> parseManifest(const std::string& manifestPath) {
+    std::ifstream file(manifestPath);
+    if (!file) throw std::runtime_error("cannot open manifest " + manifestPath);
+
+    fs::path base = fs::path(manifestPath).parent_path();
+    auto resolve = [&](const std::string& path) {
+        fs::path p(path);
+        return (p.is_relative() ? base / p : p).string();
+    };
+
+    std::vector<BatchJob> jobs;
+    std::string line;
+
+    // Skip header
+    if (!std::getline(file, line)) return jobs;
+
+    int lineNumber = 1;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream ss(line);
+        BatchJob job;
+        // Truck may be left empty when Pallets is a binary instance
+        if (!std::getline(ss, job.name, ',') || !std::getline(ss, job.palletsPath, ',') || job.palletsPath.empty()) {
+            throw std::runtime_error(manifestPath + ":" + std::to_string(lineNumber) +
+                                     ": expected Name,Pallets,Truck");
+        }
+        std::getline(ss, job.truckPath, ',');
+        job.palletsPath = resolve(job.palletsPath);
+        if (!job.truckPath.empty()) job.truckPath = resolve(job.truckPath);
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+/**
+ * @brief Formats the row of a job that could not be solved.
+ */
+std::string errorRow(const BatchJob& job, const Solver& solver, const std::string& error) {
+    return csvField(job.name) + ',' + solver.key + ",error,0,0,0," + csvField(error) + '\n';
+}
+
+/**
+ * @brief Solves one job and formats its output row.
+ *
+ * Any exception thrown while loading or solving, std::bad_alloc included,
+ * becomes an error row, so one bad job never ends the batch.
+ */
+std::string solveBatchJob(const BatchJob& job, const Solver& solver, const SolveOptions& options, bool& ok) {
+    ok = false;
+    try {
+        std::unique_ptr<Instance> instance;
+        if (isBinaryInstance(job.palletsPath)) {
+            // The mapped columns go straight into the instance arrays
+            instance = std::make_unique<Instance>(BinaryInstance(job.palletsPath));
+        } else {
+            std::vector<Pallet> pallets = parsePalletsCSV(job.palletsPath);
+            int capacity = job.truckPath.empty() ? -1 : parseTruckAndPalletsCSV(job.truckPath);
+            if (capacity < 0) return errorRow(job, solver, "cannot read truck file " + job.truckPath);
+            instance = std::make_unique<Instance>(pallets, capacity);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        SolveResult solved = solver.solve(*instance, options);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string selected;
+        for (int i : solved.solution.indices()) {
+            if (!selected.empty()) selected += ' ';
+            selected += std::to_string(i + 1);
+        }
+        std::ostringstream row;
+        row << csvField(job.name) << ',' << solved.engine << ',' << (solved.optimal ? "optimal" : "feasible") << ','
+            << solved.solution.profit() << ',' << solved.solution.weight() << ',' << seconds << ',' << selected
+            << '\n';
+        ok = true;
+        return row.str();
+    } catch (const std::exception& e) {
+        return errorRow(job, solver, e.what());
+    }
+}
+
+BatchSummary runBatch(const std::vector<BatchJob>& jobs, const Solver& solver, const SolveOptions& options,
+                      int threads, std::ostream& out) {
+    BatchSummary summary;
+    auto start = std::chrono::steady_clock::now();
+
+    SolveOptions jobOptions = options;
+    jobOptions.threads = 1;
+    jobOptions.log = nullptr;
+
+    out << "Name,Engine,Status,Profit,Weight,Seconds,Pallets\n";
+
+    // Finished rows wait here until every earlier row has been written
+    std::mutex outputMutex;
+    std::vector<std::string> rows(jobs.size());
+    std::vector<char> done(jobs.size(), 0);
+    size_t nextRow = 0;
+
+    {
+        WorkStealingPool pool(threads);
+        for (size_t index = 0; index < jobs.size(); index++) {
+            pool.submit([&, index] {
+                bool ok = false;
+                std::string row = solveBatchJob(jobs[index], solver, jobOptions, ok);
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                (ok ? summary.solved : summary.failed)++;
+                rows[index] = std::move(row);
+                done[index] = 1;
+                if (index != nextRow) return;
+                while (nextRow < jobs.size() && done[nextRow]) {
+                    out << rows[nextRow];
+                    std::string().swap(rows[nextRow]);
+                    nextRow++;
+                }
+                out.flush();
+            });
+        }
+        pool.wait();
+    }
+
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
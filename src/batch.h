@@ -0,0 +1,69 @@
+/**
+ * @file batch.h
+ * @brief Non-interactive mode solving many truck loads listed in a manifest.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "solver.h"
+
+/**
+ * @struct BatchJob
+ * @brief One truck load of a batch: a pallets file and a truck file.
+ */
+struct BatchJob {
+    std::string name;         ///< Label echoed in the output
+    std::string palletsPath;  ///< Pallets CSV, as read by parsePalletsCSV(), or a binary instance
+    std::string truckPath;    ///< Truck CSV, as read by parseTruckAndPalletsCSV(); unused for binary instances
+};
+
+/**
+ * @struct BatchSummary
+ * @brief Totals of a batch run.
+ */
+struct BatchSummary {
+    size_t solved = 0;     ///< Jobs that produced a load
+    size_t failed = 0;     ///< Jobs whose input could not be read
+    double seconds = 0;    ///< Wall-clock time of the whole run
+};
+
+/**
+ * @brief Reads a batch manifest.
+ *
+ * The manifest is a CSV file with the header Name,Pallets,Truck and one
+ * job per line. Pallets may also be a binary instance (see binary.h), in
+ * which case Truck may be empty. Relative paths are taken relative to the
+ * manifest's directory. Blank lines and lines starting with '#' are skipped.
+ *
+ * @param manifestPath Path to the manifest
+ * @return Jobs in manifest order
+ * @throws std::runtime_error if the manifest cannot be read or a line is malformed
+ */
+std::vector<BatchJob> parseManifest(const std::string& manifestPath);
+
+/**
+ * @brief Solves every job on a work-stealing pool and streams the results.
+ *
+ * Jobs run concurrently, one per worker, each engine single-threaded so the
+ * parallelism comes from the batch. Rows are written in manifest order as
+ * soon as every earlier job is done, as CSV with the header
+ * Name,Engine,Status,Profit,Weight,Seconds,Pallets. Engine is the engine
+ * that actually ran, so the auto strategy shows its pick. Pallets lists the
+ * 1-based ids of the selected pallets separated by spaces, or the error
+ * message when Status is "error".
+ *
+ * @param jobs Jobs to solve
+ * @param solver Engine used for every job
+ * @param options Options passed to the engine (threads is forced to 1)
+ * @param threads Number of concurrent jobs (0 = all hardware threads)
+ * @param out Stream receiving the CSV rows
+ * @return Counts and total time
+ */
+BatchSummary runBatch(const std::vector<BatchJob>& jobs, const Solver& solver, const SolveOptions& options,
+                      int threads, std::ostream& out);
+
+#endif // BATCH_H
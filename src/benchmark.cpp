@@ -1,85 +1,563 @@
 // benchmark.cpp
 #include "benchmark.h"            // parsePalletsCSV, parseTruckAndPalletsCSV, BenchmarkResult
+#include "binary.h"
+#include "kernels.h"
+#include "solver.h"
+#include <algorithm>
 #include <vector>
 #include <string>
-#include <future>
 #include <thread>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef GIT_REVISION
+#define GIT_REVISION "unknown"
+#endif
 
 /**
- * @brief Runs a function that returns a double (elapsed time),
- *        but aborts and returns -1.0 if it takes longer than timeoutSec.
+ * @brief Times a solver call, or returns -1.0 if it takes longer than timeoutSec.
  *
- * The lambda you pass in should capture everything it needs by value.
+ * The solver runs on the calling thread with a token whose deadline is
+ * timeoutSec away, and gives up on its own once the deadline passes.
+ * Nothing is left running in the background to skew later measurements.
  */
 template<typename Fn>
 double timeWithTimeout(Fn&& func, double timeoutSec) {
-    // package the work into a task returning double
-    std::packaged_task<double()> task{std::forward<Fn>(func)};
-    auto fut = task.get_future();
+    auto t0 = CancellationToken::Clock::now();
+    CancellationToken token(t0 + std::chrono::duration_cast<CancellationToken::Clock::duration>(
+        std::chrono::duration<double>(timeoutSec)));
+    func(&token);
+    auto t1 = CancellationToken::Clock::now();
+    if (token.stopRequested()) return -1.0;    // timed out
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+// ====================================================================== //
+// ======================== MEASUREMENT HELPERS ========================= //
+// ====================================================================== //
+
+/**
+ * @class PerfCounters
+ * @brief Cycles, instructions, cache misses and branch misses via perf_event_open.
+ *
+ * The counters follow the calling thread and the threads it creates
+ * (inherit), so the parallel engines are counted whole. User space only,
+ * which perf_event_paranoid = 2 still allows. If the kernel refuses any
+ * counter, available() is false and the benchmark reports none.
+ */
+class PerfCounters {
+public:
+    static const int count = 4;
+
+    PerfCounters() {
+        const uint64_t configs[count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < count; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
 
-    // launch on a detached thread
-    std::thread(std::move(task)).detach();
+    bool available() const {
+        return std::all_of(std::begin(fds), std::end(fds), [](int fd) { return fd >= 0; });
+    }
 
-    // wait up to timeoutSec
-    if (fut.wait_for(std::chrono::duration<double>(timeoutSec))
-        == std::future_status::ready) {
-        return fut.get();    // got the real timing
-    } else {
-        return -1.0;         // timed out
+    void start() {
+        for (int fd : fds) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
     }
+
+    std::vector<long long> stop() {
+        std::vector<long long> values(count, -1);
+        for (int i = 0; i < count; i++) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value;
+            if (read(fds[i], &value, sizeof(value)) == sizeof(value)) values[i] = (long long)value;
+        }
+        return values;
+    }
+
+private:
+    int fds[count] = {-1, -1, -1, -1};
+};
+
+/**
+ * @brief Resets the peak RSS of the process (Linux clear_refs).
+ * @return False if the kernel does not allow it; the peak is then the process-wide one
+ */
+static bool resetPeakRss() {
+    std::ofstream refs("/proc/self/clear_refs");
+    return refs && (refs << "5").flush();
 }
 
-void runBenchmarks() {
+/**
+ * @brief Peak resident set size since the last reset, in kB.
+ */
+static long peakRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::atol(line.c_str() + 6);
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief CPU model from /proc/cpuinfo, or "unknown".
+ */
+static std::string cpuModel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") != 0) continue;
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) return line.substr(line.find_first_not_of(" \t", colon + 1));
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Value at quantile q (0..1) of sorted samples, by nearest rank.
+ */
+static double quantile(const std::vector<double>& sorted, double q) {
+    size_t rank = (size_t)std::ceil(q * sorted.size());
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+/**
+ * @brief Fills median, p95, mean, stddev and min from the samples.
+ */
+static void summarize(BenchmarkResult& result) {
+    std::vector<double> sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+    result.median = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+    result.p95 = quantile(sorted, 0.95);
+    result.min = sorted.front();
+
+    double sum = 0, squares = 0;
+    for (double s : sorted) sum += s;
+    result.mean = sum / n;
+    for (double s : sorted) squares += (s - result.mean) * (s - result.mean);
+    result.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0.0;
+}
+
+/**
+ * @brief Escapes a string for a JSON literal.
+ */
+static std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::vector<int> parseNumberList(const std::string& list) {
+    std::vector<int> numbers;
+    std::istringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t dash = item.find('-', 1);
+        int first = std::stoi(item.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+        if (last < first) throw std::invalid_argument("bad range " + item);
+        for (int k = first; k <= last; k++) numbers.push_back(k);
+    }
+    return numbers;
+}
+
+// ====================================================================== //
+// ========================== BENCHMARK SUITE =========================== //
+// ====================================================================== //
+
+/**
+ * @brief Numbers of the datasets with both CSV files in the directory, sorted.
+ */
+static std::vector<int> findDatasets(const std::string& dataDir) {
+    std::vector<int> datasets;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dataDir, ec)) {
+        std::string name = entry.path().filename().string();
+        int number;
+        char tail;
+        if (std::sscanf(name.c_str(), "Pallets_%d.cs%c", &number, &tail) != 2 || tail != 'v') continue;
+        std::string ds = (number < 10 ? "0" : "") + std::to_string(number);
+        if (std::filesystem::exists(dataDir + "/TruckAndPallets_" + ds + ".csv")) datasets.push_back(number);
+    }
+    std::sort(datasets.begin(), datasets.end());
+    return datasets;
+}
+
+/**
+ * @brief Memory of the DP tables an engine keeps on the instance, in bytes.
+ *
+ * dp keeps the full (n + 1) x (C + 1) table of int cells. The bitset, SIMD
+ * and parallel DPs keep one decision bit per cell plus one row (bitset) or
+ * two rows (SIMD, parallel) of the cell width they pick for the instance,
+ * see knapsackValueBits().
+ *
+ * @return 0 for engines whose memory does not grow with n * C
+ */
+static double tableBytes(const std::string& key, const Instance& instance) {
+    double n = instance.size(), row = (double)instance.capacity() + 1;
+    if (key == "dp") return (n + 1) * row * sizeof(int);
+
+    double decisions = n * (instance.capacity() / 64 + 1) * sizeof(uint64_t);
+    double cellBytes = knapsackValueBits(instance.profitCeiling()) / 8;
+    if (key == "dp-bitset") return decisions + row * cellBytes;
+    if (key == "dp-simd" || key == "dp-parallel") return decisions + 2 * row * cellBytes;
+    return 0;
+}
+
+/**
+ * @brief Runs the selected engines on one instance.
+ *
+ * @param perf Counters to read, or nullptr
+ * @param rssPerRun Whether the peak RSS can be reset before each run
+ * @param results Receives one result per engine, with dataset, instance, n and capacity left to the caller
+ */
+static void benchmarkInstance(const std::vector<Pallet>& pallets, int capacity, const BenchmarkConfig& config,
+                              PerfCounters* perf, bool rssPerRun, std::vector<BenchmarkResult>& results) {
+    // One instance for every engine: its orders are sorted during the first warmup and then shared
+    Instance instance(pallets, capacity);
+    for (const Solver& solver : solverRegistry()) {
+        if (!config.algorithms.empty() &&
+            std::find(config.algorithms.begin(), config.algorithms.end(), solver.key) == config.algorithms.end()) {
+            continue;
+        }
+        SolveOptions options;
+        options.threads = config.threads;
+        options.epsilon = 0.1;
+        if (solver.key == "anytime") options.budget = std::chrono::milliseconds(100);
+
+        long long nodes = -1;
+        auto timedCall = [&](const CancellationToken* token) {
+            options.token = token;
+            nodes = solver.solve(instance, options).nodes;
+        };
+
+        BenchmarkResult result;
+        result.algorithm = solver.name;
+        result.key = solver.key;
+        result.n = (int)pallets.size();
+        result.capacity = capacity;
+        result.status = "ok";
+
+        // A table past the memory limit would be killed, not timed out
+        if (tableBytes(solver.key, instance) > config.memoryLimitMb * 1048576.0) {
+            result.status = "skipped";
+            results.push_back(result);
+            continue;
+        }
+        std::vector<std::vector<long long>> counterSamples;
+        std::vector<long long> nodeSamples;  // Nodes of each timed run, parallel to result.samples
+
+        // Warmup: caches, page faults and lazily built tables, not measured
+        bool timedOut = false;
+        for (int w = 0; w < config.warmup && !timedOut; w++) {
+            timedOut = timeWithTimeout(timedCall, config.timeoutSec) < 0;
+        }
+        for (int rep = 0; rep < config.repetitions && !timedOut; rep++) {
+            if (rssPerRun) resetPeakRss();
+            if (perf) perf->start();
+            double elapsed = timeWithTimeout(timedCall, config.timeoutSec);
+            if (perf) counterSamples.push_back(perf->stop());
+            result.peakRssKb = std::max(result.peakRssKb, peakRssKb());
+            if (elapsed < 0) {
+                timedOut = true;
+            } else {
+                result.samples.push_back(elapsed);
+                nodeSamples.push_back(nodes);
+            }
+        }
+
+        if (timedOut || result.samples.empty()) {
+            result.status = "timeout";
+            result.samples.clear();
+        } else {
+            summarize(result);
+            // Parallel searches expand a different number of nodes each run: take the median run's
+            std::vector<size_t> byTime(result.samples.size());
+            for (size_t k = 0; k < byTime.size(); k++) byTime[k] = k;
+            std::sort(byTime.begin(), byTime.end(),
+                      [&](size_t a, size_t b) { return result.samples[a] < result.samples[b]; });
+            size_t median = byTime[(byTime.size() - 1) / 2];
+            result.nodes = nodeSamples[median];
+            if (result.nodes >= 0 && result.samples[median] > 0) {
+                result.nodesPerSecond = result.nodes / result.samples[median];
+            }
+            for (int c = 0; c < PerfCounters::count && !counterSamples.empty(); c++) {
+                std::vector<long long> values;
+                for (const auto& sample : counterSamples) values.push_back(sample[c]);
+                std::sort(values.begin(), values.end());
+                result.counters.push_back(values[values.size() / 2]);
+            }
+        }
+        results.push_back(result);
+    }
+}
+
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkConfig& config) {
     std::vector<BenchmarkResult> results;
-    const std::vector<std::string> algorithmNames = {
-        "Exhaustive Search", "Backtracking", "Dynamic Programming", "Approximation", "ILP"
-    };
+    std::vector<int> datasets = config.datasets;
+    if (datasets.empty() && config.generated.empty()) datasets = findDatasets(config.dataDir);
+
+    std::unique_ptr<PerfCounters> perf;
+    if (config.counters) {
+        perf = std::make_unique<PerfCounters>();
+        if (!perf->available()) {
+            std::fprintf(stderr, "Hardware counters unavailable (perf_event_open refused), reporting none\n");
+            perf.reset();
+        }
+    }
+    bool rssPerRun = resetPeakRss();
 
-    // Loop datasets 1–14
-    for (int dataset = 1; dataset <= 10; ++dataset) {
-        // build zero-padded dataset string
+    for (int dataset : datasets) {
         std::string ds = (dataset < 10 ? "0" : "") + std::to_string(dataset);
-        std::string pathP = "../data/Pallets_"          + ds + ".csv";
-        std::string pathT = "../data/TruckAndPallets_" + ds + ".csv";
+        std::string pathP = config.dataDir + "/Pallets_" + ds + ".csv";
+        std::string pathT = config.dataDir + "/TruckAndPallets_" + ds + ".csv";
+        if (!std::filesystem::exists(pathP) || !std::filesystem::exists(pathT)) {
+            std::fprintf(stderr, "Dataset %d not found in %s, skipped\n", dataset, config.dataDir.c_str());
+            continue;
+        }
 
-        // parse outside the threads
+        // parse outside the measurements
         auto pallets = parsePalletsCSV(pathP);
         int capacity = parseTruckAndPalletsCSV(pathT);
 
-        // Test each of the 5 algorithms, up to 2 seconds each
-        for (int algo = 1; algo <= 5; ++algo) {
-            // Everything the lambda needs is captured by value:
-            //   - a copy of pallets
-            //   - the capacity
-            //   - the algorithm index
-            auto timedCall = [pallets, capacity, algo]() -> double {
-                auto t0 = std::chrono::high_resolution_clock::now();
-                switch (algo) {
-                    case 1: exhaustiveSearch(      pallets, capacity); break;
-                    case 2: backtracking(           pallets, capacity); break;
-                    case 3: dynamicProgramming(     pallets, capacity); break;
-                    case 4: approximationAlgorithm( pallets, capacity); break;
-                    case 5: integerLinearProgramming(pallets, capacity); break;
+        size_t first = results.size();
+        benchmarkInstance(pallets, capacity, config, perf.get(), rssPerRun, results);
+        for (size_t i = first; i < results.size(); i++) {
+            results[i].dataset = dataset;
+            results[i].instance = "Pallets_" + ds;
+        }
+    }
+
+    // Generated instances are numbered after the files, one at a time in memory
+    int lastDataset = datasets.empty() ? 0 : *std::max_element(datasets.begin(), datasets.end());
+    for (size_t g = 0; g < config.generated.size(); g++) {
+        GeneratedInstance instance = generateInstance(config.generated[g]);
+        size_t first = results.size();
+        benchmarkInstance(instance.pallets, instance.capacity, config, perf.get(), rssPerRun, results);
+        for (size_t i = first; i < results.size(); i++) {
+            results[i].dataset = lastDataset + (int)g + 1;
+            results[i].instance = instance.label;
+        }
+    }
+
+    std::string revision = GIT_REVISION, cpu = cpuModel();
+    static const char* counterNames[PerfCounters::count] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+
+    if (!config.csvPath.empty()) {
+        std::ofstream csv(config.csvPath);
+        csv << "Algorithm,Dataset,Time(sec),Key,Instance,N,Capacity,Status,Repetitions,Median,P95,Mean,StdDev,Min,"
+               "PeakRSS(kB),Cycles,Instructions,CacheMisses,BranchMisses,Nodes,Nodes/sec,Revision,CPU\n";
+        for (const BenchmarkResult& r : results) {
+            csv << csvField(r.algorithm) << ',' << r.dataset << ',' << r.median << ',' << r.key << ','
+                << csvField(r.instance) << ',' << r.n << ',' << r.capacity << ',' << r.status << ','
+                << r.samples.size() << ',' << r.median << ',' << r.p95 << ',' << r.mean << ',' << r.stddev << ','
+                << r.min << ',' << r.peakRssKb;
+            for (int c = 0; c < PerfCounters::count; c++) {
+                csv << ',';
+                if (!r.counters.empty()) csv << r.counters[c];
+            }
+            csv << ',';
+            if (r.nodes >= 0) csv << r.nodes;
+            csv << ',';
+            if (r.nodesPerSecond >= 0) csv << r.nodesPerSecond;
+            csv << ',' << csvField(revision) << ',' << csvField(cpu) << '\n';
+        }
+    }
+
+    if (!config.jsonPath.empty()) {
+        std::ofstream json(config.jsonPath);
+        json << "{\n  \"revision\": " << jsonString(revision) << ",\n  \"cpu\": " << jsonString(cpu)
+             << ",\n  \"threads\": " << config.threads << ",\n  \"warmup\": " << config.warmup
+             << ",\n  \"repetitions\": " << config.repetitions << ",\n  \"timeout_sec\": " << config.timeoutSec
+             << ",\n  \"peak_rss_per_run\": " << (rssPerRun ? "true" : "false")
+             << ",\n  \"counters\": " << (perf ? "true" : "false") << ",\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& r = results[i];
+            json << (i ? ",\n" : "\n") << "    {\"algorithm\": " << jsonString(r.algorithm)
+                 << ", \"key\": " << jsonString(r.key) << ", \"dataset\": " << r.dataset
+                 << ", \"instance\": " << jsonString(r.instance) << ", \"n\": " << r.n
+                 << ", \"capacity\": " << r.capacity << ", \"status\": " << jsonString(r.status) << ", \"samples\": [";
+            for (size_t s = 0; s < r.samples.size(); s++) json << (s ? ", " : "") << r.samples[s];
+            json << "]";
+            if (r.status == "ok") {
+                json << ", \"median\": " << r.median << ", \"p95\": " << r.p95 << ", \"mean\": " << r.mean
+                     << ", \"stddev\": " << r.stddev << ", \"min\": " << r.min;
+            }
+            json << ", \"peak_rss_kb\": " << r.peakRssKb;
+            for (int c = 0; c < PerfCounters::count; c++) {
+                json << ", \"" << counterNames[c] << "\": ";
+                if (r.counters.empty()) {
+                    json << "null";
+                } else {
+                    json << r.counters[c];
                 }
-                auto t1 = std::chrono::high_resolution_clock::now();
-                return std::chrono::duration<double>(t1 - t0).count();
-            };
+            }
+            if (r.nodes >= 0) {
+                json << ", \"nodes\": " << r.nodes << ", \"nodes_per_sec\": " << r.nodesPerSecond;
+            } else {
+                json << ", \"nodes\": null, \"nodes_per_sec\": null";
+            }
+            json << "}";
+        }
+        json << "\n  ]\n}\n";
+    }
+
+    if (config.scaling) {
+        runScalingBenchmark(config.threads > 0 ? config.threads : (int)std::thread::hardware_concurrency(),
+                            config.dataDir);
+    }
+    return results;
+}
+
+/**
+ * @brief Measures how the parallel DP scales with the thread count.
+ *
+ * Times dynamicProgrammingParallel() on datasets 06 and 11 with 1, 2, 4, ...
+ * threads up to maxThreads, keeping the best of three runs, and writes the
+ * speedup over one thread to scaling.csv.
+ */
+void runScalingBenchmark(int maxThreads, const std::string& dataDir) {
+    std::vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(std::max(1, maxThreads));
+
+    std::ofstream csv("scaling.csv");
+    csv << "Dataset,Threads,Time(sec),Speedup\n";
+    for (int dataset : {6, 11}) {
+        std::string ds = (dataset < 10 ? "0" : "") + std::to_string(dataset);
+        Instance instance(parsePalletsCSV(dataDir + "/Pallets_" + ds + ".csv"),
+                          parseTruckAndPalletsCSV(dataDir + "/TruckAndPallets_" + ds + ".csv"));
 
-            // run it, but give up after 2 seconds
-            double elapsed = timeWithTimeout(timedCall, 2.0);
-            results.push_back({ algorithmNames[algo-1], dataset, elapsed });
+        double baseline = 0;
+        for (int t : threadCounts) {
+            double best = -1;
+            for (int rep = 0; rep < 3; rep++) {
+                auto t0 = std::chrono::steady_clock::now();
+                dynamicProgrammingParallel(instance, t);
+                auto t1 = std::chrono::steady_clock::now();
+                double elapsed = std::chrono::duration<double>(t1 - t0).count();
+                if (best < 0 || elapsed < best) best = elapsed;
+            }
+            if (t == 1) baseline = best;
+            csv << dataset << ',' << t << ',' << best << ',' << baseline / best << '\n';
         }
     }
+}
+/**
+ * @brief Reference parser: the getline / istringstream / stoi loop parsePalletsCSV() replaced.
+ */
+static std::vector<Pallet> parsePalletsStream(const std::string& filePath) {
+    std::ifstream file(filePath);
+    std::vector<Pallet> pallets;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        std::istringstream ss(line);
+        std::string token;
+        Pallet p{0, 0};
+        if (!std::getline(ss, token, ',')) continue;
+        if (!std::getline(ss, token, ',')) continue;
+        p.weight = std::stoi(token);
+        if (!std::getline(ss, token, ',')) continue;
+        p.profit = std::stoi(token);
+        pallets.push_back(p);
+    }
+    return pallets;
+}
 
-    // Write all results to CSV
-    std::ofstream csv("benchmark.csv");
-    csv << "Algorithm,Dataset,Time(sec)\n";
-    for (auto& r : results) {
-        csv << r.algorithm
-            << ',' << r.dataset
-            << ',' << r.time_seconds
-            << '\n';
+/**
+ * @brief Measures pallet CSV parsing throughput.
+ *
+ * Writes a file of the given number of rows to the temporary directory,
+ * then parses it with parsePalletsCSV() and with the reference stream
+ * parser, and loads it as a binary instance, keeping the best of three
+ * runs each. Rows per second and MB per second are printed and written to
+ * parse.csv.
+ */
+void runParseBenchmark(size_t rows) {
+    std::string path = (std::filesystem::temp_directory_path() / "pallets_parse_benchmark.csv").string();
+    {
+        std::ofstream out(path);
+        std::mt19937 rng(42);
+        out << "Pallet,Weight,Profit\n";
+        for (size_t i = 1; i <= rows; i++) out << i << ',' << 1 + rng() % 1000 << ',' << 1 + rng() % 1000 << '\n';
     }
-}
\ No newline at end of file
+    double megabytes = std::filesystem::file_size(path) / 1e6;
+
+    std::ofstream csv("parse.csv");
+    csv << "Parser,Rows,Time(sec),Rows/sec,MB/sec\n";
+    std::printf("%-10s %12s %10s %14s %10s\n", "Parser", "Rows", "Time(s)", "Rows/s", "MB/s");
+
+    auto measure = [&](const char* name, auto parse) {
+        double best = -1;
+        size_t parsed = 0;
+        for (int rep = 0; rep < 3; rep++) {
+            auto t0 = std::chrono::steady_clock::now();
+            parsed = parse(path).size();
+            auto t1 = std::chrono::steady_clock::now();
+            double elapsed = std::chrono::duration<double>(t1 - t0).count();
+            if (best < 0 || elapsed < best) best = elapsed;
+        }
+        std::printf("%-10s %12zu %10.4f %14.0f %10.1f\n", name, parsed, best, parsed / best, megabytes / best);
+        csv << name << ',' << parsed << ',' << best << ',' << parsed / best << ',' << megabytes / best << '\n';
+    };
+    measure("mmap", [](const std::string& p) { return parsePalletsCSV(p); });
+    measure("stream", [](const std::string& p) { return parsePalletsStream(p); });
+
+    // The same instance in the binary format: mapping plus one copy of each column into an Instance
+    std::string binaryPath = path + ".bin";
+    writeBinaryInstance(binaryPath, parsePalletsCSV(path), Truck{1, 1000});
+    megabytes = std::filesystem::file_size(binaryPath) / 1e6;
+    measure("binary", [&](const std::string&) { return Instance(BinaryInstance(binaryPath)); });
+    std::filesystem::remove(binaryPath);
+
+    std::filesystem::remove(path);
+}
@@ -1,14 +1,79 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
 #include <chrono>
 #include <string>
 #include <vector>
 #include <fstream>
 #include "algorithms.h"
+#include "generator.h"
 #include "parser.h"
 
 struct BenchmarkResult {
     std::string algorithm;
-    int dataset;
-    double time_seconds;
+    std::string key;
+    int dataset = 0;                  ///< Number of the Pallets_XX file, generated instances follow
+    std::string instance;             ///< "Pallets_XX" or the label of the generated instance
+    int n = 0;
+    int capacity = 0;
+    std::string status;               ///< "ok", "timeout" or "skipped" (table over the memory limit)
+    std::vector<double> samples;      ///< Seconds of each measured repetition
+    double median = -1.0;             ///< -1 on timeout, as graph.py expects
+    double p95 = -1.0;
+    double mean = -1.0;
+    double stddev = -1.0;
+    double min = -1.0;
+    long peakRssKb = -1;              ///< Highest peak resident set of the repetitions
+    std::vector<long long> counters;  ///< Medians of the hardware counters, empty if unavailable
+    long long nodes = -1;             ///< Search nodes expanded by the median run, -1 for engines that do not count them
+    double nodesPerSecond = -1.0;     ///< nodes / time of the median run, -1 if either is unknown
+};
+
+/**
+ * @struct BenchmarkConfig
+ * @brief What runBenchmarks() measures and where it writes.
+ */
+struct BenchmarkConfig {
+    int threads = 0;                       ///< Threads of the parallel engines (0 = all)
+    int warmup = 1;                        ///< Unmeasured runs before the repetitions
+    int repetitions = 5;                   ///< Measured runs per algorithm and dataset
+    double timeoutSec = 2.0;               ///< A run over this counts as a timeout
+    double memoryLimitMb = 4096;           ///< Table engines needing more are skipped
+    bool counters = false;                 ///< Read cycles, instructions, cache and branch misses
+    bool scaling = false;                  ///< Also run runScalingBenchmark()
+    std::vector<std::string> algorithms;   ///< Registry keys to run (empty = all)
+    std::vector<int> datasets;             ///< Dataset numbers to run (empty = all found, unless generated is set)
+    std::vector<GeneratorConfig> generated; ///< Synthetic instances to run after the datasets
+    std::string dataDir = "../data";       ///< Directory of the Pallets_XX / TruckAndPallets_XX pairs
+    std::string csvPath = "benchmark.csv"; ///< CSV output ("" = none)
+    std::string jsonPath;                  ///< JSON output ("" = none)
 };
 
-void runBenchmarks();
\ No newline at end of file
+/**
+ * @brief Runs the benchmark suite.
+ *
+ * Every selected engine runs on every selected dataset: warmup runs first,
+ * then the measured repetitions, each under a deadline token. Reports the
+ * median, p95, mean, standard deviation and minimum of the repetitions,
+ * the peak RSS of the runs and, if requested and permitted, the medians of
+ * the hardware counters. Search engines also report the nodes expanded by
+ * the median run and its nodes per second.
+ *
+ * Generated instances are built one at a time, outside the measurements.
+ * The CSV keeps the Algorithm,Dataset,Time(sec) columns first (Time is the
+ * median, -1 on timeout); both outputs carry the git revision and the CPU
+ * model.
+ *
+ * @return Results in dataset, then registry order
+ */
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkConfig& config);
+void runScalingBenchmark(int maxThreads, const std::string& dataDir = "../data");
+void runParseBenchmark(size_t rows);
+
+/**
+ * @brief Parses a comma-separated list of numbers and ranges, e.g. "1,3,5-8".
+ * @throws std::invalid_argument on a malformed list
+ */
+std::vector<int> parseNumberList(const std::string& list);
+
+#endif // BENCHMARK_H
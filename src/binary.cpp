@@ -0,0 +1,169 @@
+/**
+ * @file binary.cpp
+ * @brief Reading, writing and converting binary instances.
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "binary.h"
+#include "mappedfile.h"
+#include "parser.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char magic[4] = {'K', 'N', 'P', 'B'};
+const size_t headerSize = 48;
+const uint32_t extraDimensionsFlag = 1;
+
+uint32_t loadLE32(const char* p) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    return (uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+uint64_t loadLE64(const char* p) {
+    return (uint64_t)loadLE32(p) | (uint64_t)loadLE32(p + 4) << 32;
+}
+
+void storeLE32(char* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) p[i] = (char)(value >> (8 * i));
+}
+
+void storeLE64(char* p, uint64_t value) {
+    storeLE32(p, (uint32_t)value);
+    storeLE32(p + 4, (uint32_t)(value >> 32));
+}
+
+const bool hostLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+/**
+ * @brief Writes one int32 array in little-endian order.
+ */
+template<typename Field>
+void writeArray(std::ofstream& out, const std::vector<Pallet>& pallets, Field field) {
+    std::vector<char> buffer(pallets.size() * 4);
+    for (size_t i = 0; i < pallets.size(); i++) storeLE32(&buffer[i * 4], (uint32_t)field(pallets[i]));
+    out.write(buffer.data(), buffer.size());
+}
+
+} // namespace
+
+BinaryInstance::BinaryInstance(const std::string& path) : file(std::make_unique<MappedFile>(path)) {
+    if (!file->ok()) throw std::runtime_error("cannot open " + path);
+    const char* data = file->begin();
+    size_t length = file->end() - data;
+    if (length < headerSize || std::memcmp(data, magic, 4) != 0) {
+        throw std::runtime_error(path + ": not a binary instance");
+    }
+    uint32_t fileVersion = loadLE32(data + 4);
+    if (fileVersion != version) {
+        throw std::runtime_error(path + ": unsupported binary instance version " + std::to_string(fileVersion));
+    }
+
+    count = loadLE64(data + 8);
+    truckLimits.capacity = (int32_t)loadLE32(data + 16);
+    uint32_t flags = loadLE32(data + 20);
+    truckLimits.volume = (int32_t)loadLE32(data + 24);
+    truckLimits.slots = (int32_t)loadLE32(data + 28);
+    truckLimits.frontAxle = (int32_t)loadLE32(data + 32);
+    truckLimits.rearAxle = (int32_t)loadLE32(data + 36);
+
+    size_t arrays = (flags & extraDimensionsFlag) ? 5 : 2;
+    if (count > (length - headerSize) / (4 * arrays)) {
+        throw std::runtime_error(path + ": truncated binary instance");
+    }
+    if (!hostLittleEndian) {
+        throw std::runtime_error(path + ": binary instances need a little-endian host");
+    }
+
+    const int32_t* arraysStart = reinterpret_cast<const int32_t*>(data + headerSize);
+    weightArray = arraysStart;
+    profitArray = arraysStart + count;
+    if (arrays == 5) extraArrays = arraysStart + 2 * count;
+}
+
+BinaryInstance::~BinaryInstance() = default;
+
+std::vector<Pallet> BinaryInstance::pallets() const {
+    std::vector<Pallet> result(count, Pallet{0, 0});
+    for (size_t i = 0; i < count; i++) {
+        result[i].weight = weightArray[i];
+        result[i].profit = profitArray[i];
+    }
+    if (extraArrays) {
+        for (size_t i = 0; i < count; i++) {
+            result[i].volume = extraArrays[i];
+            result[i].slots = extraArrays[count + i];
+            result[i].frontAxle = extraArrays[2 * count + i];
+        }
+    }
+    return result;
+}
+
+bool isBinaryInstance(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char head[4];
+    return file.read(head, 4) && std::memcmp(head, magic, 4) == 0;
+}
+
+void writeBinaryInstance(const std::string& path, const std::vector<Pallet>& pallets, const Truck& truck) {
+    bool extra = truck.volume >= 0 || truck.slots >= 0 || truck.frontAxle >= 0 || truck.rearAxle >= 0;
+    for (const Pallet& pallet : pallets) {
+        if (pallet.volume || pallet.slots || pallet.frontAxle) extra = true;
+    }
+
+    char header[headerSize] = {};
+    std::memcpy(header, magic, 4);
+    storeLE32(header + 4, BinaryInstance::version);
+    storeLE64(header + 8, pallets.size());
+    storeLE32(header + 16, (uint32_t)truck.capacity);
+    storeLE32(header + 20, extra ? extraDimensionsFlag : 0);
+    storeLE32(header + 24, (uint32_t)truck.volume);
+    storeLE32(header + 28, (uint32_t)truck.slots);
+    storeLE32(header + 32, (uint32_t)truck.frontAxle);
+    storeLE32(header + 36, (uint32_t)truck.rearAxle);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("cannot write " + path);
+    out.write(header, headerSize);
+    writeArray(out, pallets, [](const Pallet& p) { return p.weight; });
+    writeArray(out, pallets, [](const Pallet& p) { return p.profit; });
+    if (extra) {
+        writeArray(out, pallets, [](const Pallet& p) { return p.volume; });
+        writeArray(out, pallets, [](const Pallet& p) { return p.slots; });
+        writeArray(out, pallets, [](const Pallet& p) { return p.frontAxle; });
+    }
+    if (!out.flush()) throw std::runtime_error("cannot write " + path);
+}
+
+void convertCSVToBinary(const std::string& palletsPath, const std::string& truckPath, const std::string& outputPath) {
+    if (!fs::is_regular_file(palletsPath)) throw std::runtime_error("cannot open " + palletsPath);
+    std::vector<Pallet> pallets = parsePalletsCSV(palletsPath);
+    std::vector<Truck> trucks = parseTrucksCSV(truckPath);
+    if (trucks.empty()) throw std::runtime_error("no truck capacity in " + truckPath);
+    writeBinaryInstance(outputPath, pallets, trucks[0]);
+}
+
+int convertDatasetDirectory(const std::string& inputDir, const std::string& outputDir) {
+    fs::create_directories(outputDir);
+    int converted = 0;
+    for (const auto& entry : fs::directory_iterator(inputDir)) {
+        std::string name = entry.path().filename().string();
+        const std::string prefix = "Pallets_", suffix = ".csv";
+        if (name.size() <= prefix.size() + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            continue;
+        }
+        std::string id = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+        fs::path truckPath = fs::path(inputDir) / ("TruckAndPallets_" + id + suffix);
+        if (!fs::exists(truckPath)) continue;
+
+        convertCSVToBinary(entry.path().string(), truckPath.string(),
+                           (fs::path(outputDir) / ("Instance_" + id + ".bin")).string());
+        converted++;
+    }
+    return converted;
+}
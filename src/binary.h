@@ -0,0 +1,107 @@
+/**
+ * @file binary.h
+ * @brief Versioned binary instance format, memory-mapped without parsing.
+ *
+ * Layout, all integers little-endian:
+ *
+ *   offset  size  field
+ *        0     4  magic "KNPB"
+ *        4     4  version (1)
+ *        8     8  count, number of pallets
+ *       16     4  capacity
+ *       20     4  flags (bit 0: extra dimensions present)
+ *       24    16  truck volume, slots, front axle, rear axle limits (-1 = none)
+ *       40     8  reserved, zero
+ *       48        int32 weight[count], int32 profit[count]
+ *                 then, with bit 0: int32 volume[count], slots[count], frontAxle[count]
+ *
+ * Arrays are in structure-of-arrays order and 4-byte aligned; the header
+ * is 48 bytes so the mapping (page aligned) keeps them aligned.
+ */
+
+#ifndef BINARY_H
+#define BINARY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pallet.h"
+#include "truck.h"
+
+class MappedFile;
+
+/**
+ * @class BinaryInstance
+ * @brief A binary instance file mapped read-only.
+ *
+ * The weight and profit arrays point straight into the mapping; nothing is
+ * parsed or copied until an Instance copies the two columns, or pallets()
+ * builds the vector the multi-dimensional solvers take.
+ */
+class BinaryInstance {
+public:
+    static const uint32_t version = 1;
+
+    /**
+     * @brief Maps and validates a binary instance.
+     * @throws std::runtime_error if the file cannot be read, is not an
+     *         instance, has an unknown version or is truncated
+     */
+    explicit BinaryInstance(const std::string& path);
+    ~BinaryInstance();
+
+    size_t size() const { return count; }
+    int capacity() const { return truckLimits.capacity; }
+    const Truck& truck() const { return truckLimits; }
+
+    const int32_t* weights() const { return weightArray; }
+    const int32_t* profits() const { return profitArray; }
+
+    /**
+     * @brief Builds the pallets, including the extra dimensions when present.
+     * @complexity Time: O(n)
+     */
+    std::vector<Pallet> pallets() const;
+
+private:
+    std::unique_ptr<MappedFile> file;
+    size_t count = 0;
+    Truck truckLimits{1, 0};
+    const int32_t* weightArray = nullptr;
+    const int32_t* profitArray = nullptr;
+    const int32_t* extraArrays = nullptr;   ///< volume, slots and front axle arrays, or nullptr
+};
+
+/**
+ * @brief Checks the magic number of a file.
+ * @return True if the file starts like a binary instance
+ */
+bool isBinaryInstance(const std::string& path);
+
+/**
+ * @brief Writes a binary instance.
+ *
+ * The extra dimensions are stored only if a pallet or the truck uses them.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeBinaryInstance(const std::string& path, const std::vector<Pallet>& pallets, const Truck& truck);
+
+/**
+ * @brief Converts a Pallets CSV and its truck CSV into a binary instance.
+ * @throws std::runtime_error on malformed or unreadable input, or if the output cannot be written
+ */
+void convertCSVToBinary(const std::string& palletsPath, const std::string& truckPath, const std::string& outputPath);
+
+/**
+ * @brief Converts every Pallets_XX.csv / TruckAndPallets_XX.csv pair of a directory.
+ *
+ * Each pair becomes Instance_XX.bin in the output directory.
+ *
+ * @return Number of instances written
+ * @throws std::runtime_error as convertCSVToBinary()
+ */
+int convertDatasetDirectory(const std::string& inputDir, const std::string& outputDir);
+
+#endif // BINARY_H
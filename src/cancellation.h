@@ -0,0 +1,60 @@
+/**
+ * @file cancellation.h
+ * @brief Cooperative cancellation token shared between a caller and a running solver.
+ */
+
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * @class CancellationToken
+ * @brief Stop flag plus optional deadline that long-running solvers poll.
+ *
+ * The caller may cancel() from any thread; solvers call stopRequested()
+ * every few thousand steps and return their best result so far once it
+ * turns true. The deadline must be set before the token is handed out.
+ */
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() : cancelled(false), deadline(Clock::time_point::max()) {}
+
+    explicit CancellationToken(Clock::time_point deadline) : cancelled(false), deadline(deadline) {}
+
+    /**
+     * @brief Asks every solver polling this token to stop.
+     */
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Sets the time after which stopRequested() turns true.
+     */
+    void setDeadline(Clock::time_point when) { deadline = when; }
+
+    Clock::time_point getDeadline() const { return deadline; }
+
+    /**
+     * @brief True once cancel() was called or the deadline has passed.
+     */
+    bool stopRequested() const {
+        return cancelled.load(std::memory_order_relaxed) || Clock::now() >= deadline;
+    }
+
+private:
+    std::atomic<bool> cancelled;
+    Clock::time_point deadline;
+};
+
+/**
+ * @brief Null-safe poll for solvers whose token is optional.
+ * @return False when token is null, token->stopRequested() otherwise
+ */
+inline bool stopRequested(const CancellationToken* token) {
+    return token && token->stopRequested();
+}
+
+#endif // CANCELLATION_H
@@ -0,0 +1,239 @@
+/**
+ * @file check.cpp
+ * @brief Cross-engine agreement check over the datasets and generated instances.
+ *
+ * Every registered engine solves every instance, and the results are
+ * checked against each other: each load must fit and add up to the totals
+ * it reports, every load claimed optimal must reach the same profit, and
+ * no heuristic load or reported upper bound may contradict that optimum.
+ * Where the data directory has an OptimalSolution_XX.txt, the optimum
+ * must be at least the profit of the load it lists. Run with `make test`;
+ * the exit status is 1 if any instance failed.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "generator.h"
+#include "parser.h"
+#include "solver.h"
+
+// ====================================================================== //
+// ============================== CHECKS ================================ //
+// ====================================================================== //
+
+/// Longest an engine may take on one instance before the check calls it hung
+const std::chrono::seconds solveLimit(60);
+
+/**
+ * @brief Whether an engine is run on the instance at all.
+ *
+ * Exponential engines are held to small instances and the full-table DP
+ * to tables of at most 5e7 cells; the rest run everywhere.
+ */
+bool engineFits(const std::string& key, const Instance& instance) {
+    double n = instance.size();
+    if (key == "exhaustive" || key == "backtracking") return n <= 24;
+    if (key == "mitm") return n <= 40;
+    if (key == "dp") return (n + 1) * ((double)instance.capacity() + 1) <= 5e7;
+    return true;
+}
+
+/**
+ * @brief Profit of the load listed in an OptimalSolution_XX.txt file.
+ *
+ * Not every listed load is optimal (dataset 06 lists 1919 where 2047
+ * fits), so the check only holds the optimum to be at least this profit.
+ *
+ * @return The profit, or -1 if the file does not exist
+ */
+long long listedProfit(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return -1;
+    long long total = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        // Pallet, Weight, Profit
+        std::istringstream ss(line);
+        std::string pallet, weight, profit;
+        if (std::getline(ss, pallet, ',') && std::getline(ss, weight, ',') && std::getline(ss, profit, ',')) {
+            total += std::stoll(profit);
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Runs every engine on one instance and checks that they agree.
+ *
+ * @param label Name printed with each failure
+ * @param listed Profit of a known feasible load, or -1 if none
+ * @return Number of failed checks
+ */
+int checkInstance(const std::string& label, const Instance& instance, long long listed) {
+    struct Run {
+        const Solver* solver;
+        SolveResult result;
+    };
+    std::vector<Run> runs;
+    int failures = 0;
+    auto fail = [&](const std::string& key, const std::string& what) {
+        std::printf("FAIL %s [%s]: %s\n", label.c_str(), key.c_str(), what.c_str());
+        failures++;
+    };
+
+    for (const Solver& solver : solverRegistry()) {
+        if (!engineFits(solver.key, instance)) continue;
+        CancellationToken token(CancellationToken::Clock::now() + solveLimit);
+        SolveOptions options;
+        options.token = &token;
+        options.budget = std::chrono::milliseconds(200);
+        SolveResult result = solver.solve(instance, options);
+        if (solver.exact && !result.optimal) {
+            fail(solver.key, "no optimal load within the time limit");
+            continue;
+        }
+
+        // The load must fit and match the totals it reports
+        long long weight = 0, profit = 0;
+        for (int i : result.solution.indices()) {
+            weight += instance.weight(i);
+            profit += instance.profit(i);
+        }
+        if (weight != result.solution.weight() || profit != result.solution.profit()) {
+            fail(solver.key, "reported totals " + std::to_string(result.solution.profit()) + "/" +
+                                 std::to_string(result.solution.weight()) + " but the pallets add up to " +
+                                 std::to_string(profit) + "/" + std::to_string(weight));
+        }
+        if (weight > instance.capacity()) {
+            fail(solver.key, "load of " + std::to_string(weight) + " over capacity " +
+                                 std::to_string(instance.capacity()));
+        }
+        runs.push_back({&solver, std::move(result)});
+    }
+
+    // The optimum is the best profit among the loads claimed optimal
+    long long optimum = -1;
+    std::string optimumKey;
+    for (const Run& run : runs) {
+        if (run.result.optimal && run.result.solution.profit() > optimum) {
+            optimum = run.result.solution.profit();
+            optimumKey = run.solver->key;
+        }
+    }
+    if (optimum < 0) {
+        fail("-", "no engine proved an optimum");
+        return failures;
+    }
+    if (optimum < listed) {
+        fail(optimumKey, "optimum " + std::to_string(optimum) + " below the listed load of " +
+                             std::to_string(listed));
+    }
+
+    for (const Run& run : runs) {
+        const std::string& key = run.solver->key;
+        long long profit = run.result.solution.profit();
+        if (run.result.optimal && profit != optimum) {
+            fail(key, "claims optimal profit " + std::to_string(profit) + " but " + optimumKey + " reached " +
+                          std::to_string(optimum));
+        }
+        if (!run.result.optimal && run.result.upperBound >= 0 && run.result.upperBound < optimum) {
+            fail(key, "upper bound " + std::to_string(run.result.upperBound) + " below the optimum " +
+                          std::to_string(optimum));
+        }
+    }
+    return failures;
+}
+
+// ====================================================================== //
+// ============================= INSTANCES ============================== //
+// ====================================================================== //
+
+/**
+ * @brief Small random instances with the corner cases the families never draw.
+ *
+ * Weightless pallets, pallets that earn nothing or lose money, equal
+ * ratios, pallets heavier than the truck and an empty truck.
+ */
+std::vector<GeneratedInstance> cornerInstances() {
+    std::vector<GeneratedInstance> instances;
+    std::mt19937_64 rng(7);
+    for (int k = 0; k < 40; k++) {
+        GeneratedInstance instance;
+        int n = 1 + rng() % 24;
+        long long total = 0;
+        for (int i = 0; i < n; i++) {
+            Pallet pallet{0, 0};
+            switch (k % 4) {
+            case 0:  // weightless pallets and losses
+                pallet.weight = rng() % 6;
+                pallet.profit = (int)(rng() % 45) - 5;
+                break;
+            case 1:  // subset sum: every ratio equal
+                pallet.weight = 1 + rng() % 40;
+                pallet.profit = pallet.weight;
+                break;
+            case 2:  // a few pallets heavier than the truck
+                pallet.weight = 1 + rng() % 80;
+                pallet.profit = 1 + rng() % 40;
+                break;
+            default:  // small values, many ties
+                pallet.weight = 1 + rng() % 4;
+                pallet.profit = rng() % 4;
+                break;
+            }
+            total += pallet.weight;
+            instance.pallets.push_back(pallet);
+        }
+        instance.capacity = k % 10 == 9 ? 0 : (int)(total / 2);
+        instance.label = "corner-" + std::to_string(k);
+        instances.push_back(instance);
+    }
+    return instances;
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataDir = argc > 1 ? argv[1] : "../data";
+    int instances = 0, failed = 0;
+    auto run = [&](const std::string& label, const Instance& instance, long long listed) {
+        instances++;
+        if (checkInstance(label, instance, listed) > 0) failed++;
+    };
+
+    // The datasets shipped with the repository
+    for (int number = 1; number <= 99; number++) {
+        std::string ds = (number < 10 ? "0" : "") + std::to_string(number);
+        std::string pallets = dataDir + "/Pallets_" + ds + ".csv";
+        std::string truck = dataDir + "/TruckAndPallets_" + ds + ".csv";
+        if (!std::filesystem::exists(pallets) || !std::filesystem::exists(truck)) continue;
+        Instance instance(parsePalletsCSV(pallets), parseTruckAndPalletsCSV(truck));
+        run("Pallets_" + ds, instance, listedProfit(dataDir + "/OptimalSolution_" + ds + ".txt"));
+    }
+
+    // Every family at a few sizes and seeds, kept small enough for the exponential engines
+    for (const InstanceFamily& family : instanceFamilies()) {
+        for (int n : {8, 20, 36}) {
+            for (uint64_t seed = 1; seed <= 3; seed++) {
+                GeneratorConfig config;
+                config.family = family.key;
+                config.n = n;
+                config.range = 100;
+                config.seed = seed;
+                GeneratedInstance generated = generateInstance(config);
+                run(generated.label, Instance(generated.pallets, generated.capacity), -1);
+            }
+        }
+    }
+
+    for (const GeneratedInstance& corner : cornerInstances()) {
+        run(corner.label, Instance(corner.pallets, corner.capacity), -1);
+    }
+
+    std::printf("%d instances checked, %d failed\n", instances, failed);
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,487 @@
+/**
+ * @file fleet.cpp
+ * @brief Greedy+repair heuristic and exact bound-and-bound for the multiple knapsack.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "algorithms.h"
+#include "fleet.h"
+#include "threadpool.h"
+
+// ====================================================================== //
+// ========================== FLEET HEURISTIC =========================== //
+// ====================================================================== //
+
+/**
+ * @brief Best single-truck load among the candidate pallets.
+ *
+ * @param pallets Vector of pallet objects
+ * @param candidates Indices of the pallets the truck may take
+ * @param capacity Truck capacity
+ * @param engine Single-truck engine
+ * @param options Options for the engine
+ * @param chosen Receives the selected pallet indices
+ * @return Profit of the selected pallets
+ */
+long long solveTruck(const std::vector<Pallet>& pallets, const std::vector<int>& candidates, int capacity,
+                     const Solver& engine, const SolveOptions& options, std::vector<int>& chosen) {
+    std::vector<int> weights, profits;
+    weights.reserve(candidates.size());
+    profits.reserve(candidates.size());
+    for (int index : candidates) {
+        weights.push_back(pallets[index].weight);
+        profits.push_back(pallets[index].profit);
+    }
+
+    Instance subset(std::move(weights), std::move(profits), capacity);
+    SolveResult solved = engine.solve(subset, options);
+    chosen.clear();
+    for (int i : solved.solution.indices()) chosen.push_back(candidates[i]);
+    return solved.solution.profit();
+}
+
+/**
+ * @brief Mutable state of the heuristic: assignment and residual capacities.
+ */
+struct FleetLoad {
+    std::vector<int> truckOf;
+    std::vector<long long> residual;
+    std::vector<long long> profit;   ///< Profit per truck
+
+    void assign(const std::vector<Pallet>& pallets, int item, int truck) {
+        if (truckOf[item] >= 0) {
+            residual[truckOf[item]] += pallets[item].weight;
+            profit[truckOf[item]] -= pallets[item].profit;
+        }
+        truckOf[item] = truck;
+        if (truck >= 0) {
+            residual[truck] -= pallets[item].weight;
+            profit[truck] += pallets[item].profit;
+        }
+    }
+};
+
+/**
+ * @brief Re-solves every truck in parallel over its own and the unassigned pallets.
+ *
+ * Improvements are applied by decreasing gain. A new load that takes an
+ * unassigned pallet already claimed by an earlier accepted truck is skipped
+ * in this round.
+ *
+ * @return True if any truck improved
+ */
+bool reoptimizeTrucks(const std::vector<Pallet>& pallets, const std::vector<Truck>& trucks, FleetLoad& load,
+                      const Solver& engine, const SolveOptions& options, WorkStealingPool& pool) {
+    int n = pallets.size(), m = trucks.size();
+    std::vector<int> unassigned;
+    for (int i = 0; i < n; i++) {
+        if (load.truckOf[i] < 0 && pallets[i].profit > 0) unassigned.push_back(i);
+    }
+    if (unassigned.empty()) return false;
+
+    std::vector<std::vector<int>> loads(m);
+    std::vector<long long> gains(m, 0);
+    for (int t = 0; t < m; t++) {
+        pool.submit([&, t] {
+            std::vector<int> candidates;
+            for (int i = 0; i < n; i++) {
+                if (load.truckOf[i] == t) candidates.push_back(i);
+            }
+            for (int i : unassigned) {
+                if (pallets[i].weight <= trucks[t].capacity) candidates.push_back(i);
+            }
+            gains[t] = solveTruck(pallets, candidates, trucks[t].capacity, engine, options, loads[t]) - load.profit[t];
+        });
+    }
+    pool.wait();
+
+    std::vector<int> order(m);
+    for (int t = 0; t < m; t++) order[t] = t;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return gains[a] > gains[b]; });
+
+    std::vector<char> claimed(n, 0);
+    bool improved = false;
+    for (int t : order) {
+        if (gains[t] <= 0) break;
+        bool conflict = false;
+        for (int i : loads[t]) {
+            if (load.truckOf[i] != t && (claimed[i] || load.truckOf[i] >= 0)) conflict = true;
+        }
+        if (conflict) continue;
+
+        for (int i = 0; i < n; i++) {
+            if (load.truckOf[i] == t) load.assign(pallets, i, -1);
+        }
+        for (int i : loads[t]) {
+            claimed[i] = 1;
+            load.assign(pallets, i, t);
+        }
+        improved = true;
+    }
+    return improved;
+}
+
+/**
+ * @brief Tries to make room for unassigned pallets by moving or swapping loaded ones.
+ *
+ * For an unassigned pallet u that does not fit in truck i, a pallet a of
+ * truck i is moved to another truck j, possibly in exchange for a lighter
+ * pallet b of j, when that frees enough room in i for u.
+ *
+ * @return True if any pallet was inserted
+ *
+ * @complexity Time: O(u * n^2) - u unassigned pallets
+ */
+bool swapIntoRoom(const std::vector<Pallet>& pallets, FleetLoad& load) {
+    int n = pallets.size(), m = load.residual.size();
+    std::vector<int> unassigned;
+    for (int i = 0; i < n; i++) {
+        if (load.truckOf[i] < 0 && pallets[i].profit > 0) unassigned.push_back(i);
+    }
+    std::stable_sort(unassigned.begin(), unassigned.end(), [&](int a, int b) {
+        return pallets[a].profit > pallets[b].profit;
+    });
+
+    bool inserted = false;
+    for (int u : unassigned) {
+        bool placed = false;
+        for (int t = 0; t < m && !placed; t++) {
+            if (load.residual[t] >= pallets[u].weight) {
+                load.assign(pallets, u, t);
+                placed = true;
+            }
+        }
+        for (int a = 0; a < n && !placed; a++) {
+            int i = load.truckOf[a];
+            if (i < 0) continue;
+            long long need = pallets[u].weight - load.residual[i];
+            if (need <= 0 || pallets[a].weight < need) continue;
+
+            for (int j = 0; j < m && !placed; j++) {
+                if (j == i) continue;
+                // Move a alone
+                if (load.residual[j] >= pallets[a].weight) {
+                    load.assign(pallets, a, j);
+                    load.assign(pallets, u, i);
+                    placed = true;
+                    break;
+                }
+                // Swap a with a lighter b of truck j
+                for (int b = 0; b < n; b++) {
+                    if (load.truckOf[b] != j) continue;
+                    long long delta = pallets[a].weight - pallets[b].weight;
+                    if (delta >= need && load.residual[j] >= delta) {
+                        load.assign(pallets, a, j);
+                        load.assign(pallets, b, i);
+                        load.assign(pallets, u, i);
+                        placed = true;
+                        break;
+                    }
+                }
+            }
+        }
+        inserted |= placed;
+    }
+    return inserted;
+}
+
+FleetResult fleetHeuristic(const std::vector<Pallet>& pallets, const std::vector<Truck>& trucks,
+                           const SolveOptions& options, const Solver* engine) {
+    int n = pallets.size(), m = trucks.size();
+    if (!engine) engine = findSolver("auto");
+
+    SolveOptions single = options;
+    single.threads = 1;
+    single.log = nullptr;
+
+    FleetLoad load{std::vector<int>(n, -1), std::vector<long long>(m), std::vector<long long>(m, 0)};
+    for (int t = 0; t < m; t++) load.residual[t] = std::max(0, trucks[t].capacity);
+
+    // Smallest trucks first, each takes the best of what is left
+    std::vector<int> order(m);
+    for (int t = 0; t < m; t++) order[t] = t;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return trucks[a].capacity < trucks[b].capacity;
+    });
+    std::vector<int> candidates, chosen;
+    for (int t : order) {
+        candidates.clear();
+        for (int i = 0; i < n; i++) {
+            if (load.truckOf[i] < 0 && pallets[i].profit > 0 && pallets[i].weight <= load.residual[t]) {
+                candidates.push_back(i);
+            }
+        }
+        solveTruck(pallets, candidates, load.residual[t], *engine, single, chosen);
+        for (int i : chosen) load.assign(pallets, i, t);
+    }
+
+    // Repair until neither step finds anything
+    WorkStealingPool pool(options.threads);
+    for (int round = 0; round < 4 * m + 4 && !stopRequested(options.token); round++) {
+        bool improved = reoptimizeTrucks(pallets, trucks, load, *engine, single, pool);
+        improved |= swapIntoRoom(pallets, load);
+        if (!improved) break;
+    }
+
+    FleetResult result;
+    result.truckOf = load.truckOf;
+    for (int t = 0; t < m; t++) result.profit += load.profit[t];
+    return result;
+}
+
+// ====================================================================== //
+// ======================= FLEET BOUND-AND-BOUND ======================== //
+// ====================================================================== //
+
+// Largest DP, in cells, computed at a node for the integral surrogate bound
+const double surrogateCellLimit = 1 << 16;
+
+/**
+ * @struct FleetIncumbent
+ * @brief Best assignment found by any worker of the fleet search.
+ */
+struct FleetIncumbent {
+    std::atomic<long long> profit{-1};
+    std::vector<int> truckOf;
+    std::mutex mutex;
+
+    void offer(long long newProfit, const std::vector<int>& assignment) {
+        if (newProfit <= profit.load(std::memory_order_relaxed)) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (newProfit > profit.load(std::memory_order_relaxed)) {
+            truckOf = assignment;
+            profit.store(newProfit, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @struct FleetNode
+ * @brief Partial assignment at a node of the fleet search.
+ */
+struct FleetNode {
+    std::vector<long long> residual;
+    std::vector<int> truckOf;
+    long long profit;
+    long long totalResidual;
+};
+
+/**
+ * @struct FleetSearch
+ * @brief Instance data and shared state of a fleet search.
+ */
+struct FleetSearch {
+    const Instance& instance;
+    const RatioPrefix& rp;
+    int spawnDepth;
+    WorkStealingPool& pool;
+    const CancellationToken* token;
+    FleetIncumbent incumbent;
+    std::atomic<bool> stopped{false};
+};
+
+/**
+ * @brief Best-fit greedy over the pallets order[level..n), used as the node lower bound.
+ *
+ * @param picks Receives (pallet, truck) pairs of the greedy load
+ * @return Profit of the greedy load
+ */
+long long fleetGreedyBound(const FleetSearch& search, const FleetNode& node, int level,
+                           std::vector<std::pair<int, int>>& picks) {
+    std::vector<long long> residual = node.residual;
+    long long profit = 0;
+    picks.clear();
+    for (size_t k = level; k < search.rp.order.size(); k++) {
+        int item = search.rp.order[k];
+        int weight = search.instance.weight(item);
+        if (search.instance.profit(item) <= 0) continue;
+        int best = -1;
+        for (size_t t = 0; t < residual.size(); t++) {
+            if (residual[t] >= weight && (best < 0 || residual[t] < residual[best])) best = t;
+        }
+        if (best < 0) continue;
+        residual[best] -= weight;
+        profit += search.instance.profit(item);
+        picks.push_back({item, best});
+    }
+    return profit;
+}
+
+/**
+ * @brief Exact surrogate bound: the pallets order[level..n) packed into one truck of the total residual capacity.
+ *
+ * @complexity Time: O((n - level) * capacity)
+ * @complexity Space: O(capacity), reused per thread
+ */
+long long surrogateBound(const FleetSearch& search, int level, long long capacity) {
+    thread_local std::vector<long long> row;
+    row.assign(capacity + 1, 0);
+    for (size_t k = level; k < search.rp.order.size(); k++) {
+        int item = search.rp.order[k];
+        int weight = search.instance.weight(item), profit = search.instance.profit(item);
+        if (profit <= 0 || weight > capacity) continue;
+        for (long long c = capacity; c >= weight; c--) {
+            row[c] = std::max(row[c], row[c - weight] + profit);
+        }
+    }
+    return row[capacity];
+}
+
+/**
+ * @brief Offers a node and its greedy completion, then bounds it.
+ *
+ * @param picks Scratch for the greedy completion
+ * @return True if the search must branch below the node
+ */
+bool fleetNodeOpen(FleetSearch& search, const FleetNode& node, int level, long long& steps,
+                   std::vector<std::pair<int, int>>& picks) {
+    if (search.stopped.load(std::memory_order_relaxed)) return false;
+    if ((++steps & 1023) == 0 && stopRequested(search.token)) {
+        search.stopped.store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    search.incumbent.offer(node.profit, node.truckOf);
+    int n = search.rp.order.size();
+    if (level == n) return false;
+
+    long long upper = node.profit + martelloTothBound(search.instance, level, node.totalResidual);
+    if (upper <= search.incumbent.profit.load(std::memory_order_relaxed)) return false;
+
+    // Small remainders afford the integral surrogate, which closes most of the LP gap
+    if ((double)(n - level) * (node.totalResidual + 1) <= surrogateCellLimit) {
+        upper = std::min(upper, node.profit + surrogateBound(search, level, node.totalResidual));
+        if (upper <= search.incumbent.profit.load(std::memory_order_relaxed)) return false;
+    }
+
+    // Lower bound: a node whose greedy completion meets its upper bound is solved
+    long long lower = node.profit + fleetGreedyBound(search, node, level, picks);
+    if (lower > search.incumbent.profit.load(std::memory_order_relaxed)) {
+        std::vector<int> completed = node.truckOf;
+        for (const auto& pick : picks) completed[pick.first] = pick.second;
+        search.incumbent.offer(lower, completed);
+    }
+    return lower < upper;
+}
+
+/**
+ * @brief Depth-first bound-and-bound below a node; spawns tasks above spawnDepth.
+ *
+ * The search is iterative: one frame per open level records the next truck
+ * to try for its pallet and the truck to take the pallet back from. The
+ * children of a node are the trucks of distinct residual capacity that fit
+ * its pallet, then leaving the pallet out. Above spawnDepth each child is
+ * handed to the pool with a copy of the node instead.
+ *
+ * @complexity Time: O((m + 1)^(n - level) * n * m) - Worst case
+ * @complexity Space: O(n + m) - Frames and the node, plus a node copy per spawned task
+ */
+void fleetBranch(FleetSearch& search, FleetNode& node, int level) {
+    struct Frame {
+        int level;
+        int next;      ///< Next truck to try; m leaves the pallet out, m + 1 is done
+        int assigned;  ///< Truck holding the pallet of the current child, or -1
+    };
+
+    int m = node.residual.size();
+    long long steps = 0;  // Nodes of this task, paces the token polls
+    std::vector<std::pair<int, int>> picks;
+    std::vector<Frame> frames;
+    frames.reserve(search.rp.order.size() - level + 1);
+    if (fleetNodeOpen(search, node, level, steps, picks)) frames.push_back({level, 0, -1});
+
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        int item = search.rp.order[frame.level];
+        int weight = search.instance.weight(item), profit = search.instance.profit(item);
+        if (frame.assigned >= 0) {
+            int t = frame.assigned;
+            node.truckOf[item] = -1;
+            node.profit -= profit;
+            node.totalResidual += weight;
+            node.residual[t] += weight;
+            frame.assigned = -1;
+        }
+
+        int t = profit > 0 ? frame.next : std::max(frame.next, m);
+        for (; t < m; t++) {
+            if (weight > node.residual[t]) continue;
+            // Trucks with the same residual capacity are interchangeable
+            bool seen = false;
+            for (int u = 0; u < t && !seen; u++) seen = node.residual[u] == node.residual[t];
+            if (!seen) break;
+        }
+        if (t > m) {
+            frames.pop_back();
+            continue;
+        }
+        frame.next = t + 1;
+        if (t < m) {
+            node.residual[t] -= weight;
+            node.totalResidual -= weight;
+            node.profit += profit;
+            node.truckOf[item] = t;
+            frame.assigned = t;
+        }
+
+        int childLevel = frame.level + 1;
+        if (frame.level < search.spawnDepth) {
+            auto child = std::make_shared<FleetNode>(node);
+            search.pool.submit([&search, child, childLevel] { fleetBranch(search, *child, childLevel); });
+        } else if (fleetNodeOpen(search, node, childLevel, steps, picks)) {
+            frames.push_back({childLevel, 0, -1});
+        }
+    }
+}
+
+FleetResult fleetBranchAndBound(const std::vector<Pallet>& pallets, const std::vector<Truck>& trucks,
+                                const SolveOptions& options) {
+    int n = pallets.size(), m = trucks.size();
+    FleetResult seed = fleetHeuristic(pallets, trucks, options);
+    if (m == 0) {
+        seed.optimal = true;
+        return seed;
+    }
+
+    FleetNode root{std::vector<long long>(m), std::vector<int>(n, -1), 0, 0};
+    for (int t = 0; t < m; t++) {
+        root.residual[t] = std::max(0, trucks[t].capacity);
+        root.totalResidual += root.residual[t];
+    }
+
+    // The whole fleet as one truck: the surrogate problem, whose ratio order the search follows
+    bool surrogateFits = root.totalResidual <= std::numeric_limits<int>::max();
+    Instance instance(pallets, surrogateFits ? (int)root.totalResidual : std::numeric_limits<int>::max());
+    WorkStealingPool pool(options.threads);
+
+    // About 2^spawnDepth tasks or more, enough for every worker to find something to steal
+    int spawnDepth = 0;
+    for (long long tasks = 1; tasks < 16LL * pool.size() && spawnDepth < n; tasks *= m + 1) spawnDepth++;
+
+    FleetSearch search{instance, instance.ratioPrefix(), spawnDepth, pool, options.token, {}, {false}};
+    search.incumbent.offer(seed.profit, seed.truckOf);
+    long long rootBound = martelloTothBound(instance, 0, root.totalResidual);
+
+    // The surrogate problem solved exactly is the classic bound of the multiple knapsack
+    if (surrogateFits) {
+        SolveOptions surrogate = options;
+        surrogate.log = nullptr;
+        SolveResult solved = findSolver("auto")->solve(instance, surrogate);
+        if (solved.optimal) rootBound = std::min(rootBound, solved.solution.profit());
+    }
+
+    if (seed.profit < rootBound) pool.submit([&search, &root] { fleetBranch(search, root, 0); });
+    pool.wait();
+
+    FleetResult result;
+    result.truckOf = search.incumbent.truckOf;
+    result.profit = search.incumbent.profit.load();
+    result.optimal = !search.stopped.load();
+    if (!result.optimal) result.upperBound = std::max(rootBound, result.profit);
+    return result;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file fleet.h
+ * @brief Multiple knapsack: one pool of pallets shared by a fleet of trucks.
+ */
+
+#ifndef FLEET_H
+#define FLEET_H
+
+#include <vector>
+#include "pallet.h"
+#include "solver.h"
+#include "truck.h"
+
+/**
+ * @struct FleetResult
+ * @brief Assignment of pallets to trucks.
+ */
+struct FleetResult {
+    std::vector<int> truckOf;    ///< For each pallet, index into the trucks, or -1 if left behind
+    long long profit = 0;        ///< Total profit of the loaded pallets
+    bool optimal = false;        ///< True if the assignment is proven optimal
+    long long upperBound = -1;   ///< Proven bound on the optimum when not optimal, -1 if unknown
+};
+
+/**
+ * @brief Fast fleet heuristic: sequential single-truck solves, then repair.
+ *
+ * Trucks are filled one at a time, smallest first, each by the single-truck
+ * engine over the pallets still unassigned. Repair rounds then re-solve every
+ * truck in parallel over its own pallets plus the unassigned ones and keep
+ * the non-conflicting improvements, and try pallet swaps between trucks that
+ * make room for an unassigned pallet.
+ *
+ * @param pallets Vector of pallet objects
+ * @param trucks Trucks of the fleet
+ * @param options threads sets the repair parallelism, token stops the repair
+ * @param engine Single-truck engine (nullptr = the auto strategy)
+ * @return Assignment, never proven optimal
+ *
+ * @complexity Time: m single-truck solves, then rounds of m parallel solves
+ * @complexity Space: O(n + m) plus the engine's needs
+ */
+FleetResult fleetHeuristic(const std::vector<Pallet>& pallets, const std::vector<Truck>& trucks,
+                           const SolveOptions& options, const Solver* engine = nullptr);
+
+/**
+ * @brief Exact fleet solver by bound-and-bound.
+ *
+ * Depth-first search assigning pallets in ratio order to a truck or to no
+ * truck. The upper bound of a node is the Martello-Toth bound of the
+ * surrogate relaxation (one truck holding the total residual capacity),
+ * tightened to the surrogate's integral optimum at the root and wherever
+ * the remaining DP is small.
+ * Each node also runs a best-fit greedy on the remaining pallets; that lower
+ * bound updates the incumbent, and a node whose lower bound meets its upper
+ * bound is closed without branching. Trucks with equal residual capacity are
+ * interchangeable, so only one of them is tried. Subtrees near the root are
+ * searched in parallel on a work-stealing pool, seeded by fleetHeuristic().
+ *
+ * @param pallets Vector of pallet objects
+ * @param trucks Trucks of the fleet
+ * @param options threads sets the parallelism, token stops the search
+ * @return Optimal assignment, or the best found with a bound if stopped
+ *
+ * @complexity Time: O((m + 1)^n * n * m) - Worst case, bounds prune most of it
+ * @complexity Space: O(n * m * tasks)
+ */
+FleetResult fleetBranchAndBound(const std::vector<Pallet>& pallets, const std::vector<Truck>& trucks,
+                                const SolveOptions& options);
+
+#endif // FLEET_H
@@ -0,0 +1,188 @@
+/**
+ * @file generator.cpp
+ * @brief Instance families and the generator of synthetic instances.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "binary.h"
+#include "generator.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Largest R accepted, so that every family keeps weights and profits in an int
+const int maxRange = 100000000;
+
+/**
+ * @brief Uniform integer in [lo, hi].
+ *
+ * std::uniform_int_distribution is not specified exactly and differs
+ * between standard libraries; mt19937_64 is, so reducing its output here
+ * keeps instances identical everywhere. The modulo bias is below 2^-30.
+ */
+long long uniform(std::mt19937_64& rng, long long lo, long long hi) {
+    return lo + (long long)(rng() % (uint64_t)(hi - lo + 1));
+}
+
+// Single items of the basic families, weights in [1, R]
+
+Pallet uncorrelatedItem(std::mt19937_64& rng, int range) {
+    int weight = (int)uniform(rng, 1, range);
+    return {weight, (int)uniform(rng, 1, range)};
+}
+
+Pallet weaklyCorrelatedItem(std::mt19937_64& rng, int range) {
+    int weight = (int)uniform(rng, 1, range);
+    return {weight, (int)uniform(rng, std::max(1, weight - range / 10), weight + range / 10)};
+}
+
+Pallet stronglyCorrelatedItem(std::mt19937_64& rng, int range) {
+    int weight = (int)uniform(rng, 1, range);
+    return {weight, weight + range / 10};
+}
+
+/**
+ * @brief Family of items built from a small spanner set (spanner(v, m)).
+ *
+ * v spanner items are drawn from the basic family and scaled down by m/2;
+ * every pallet is then a random spanner item times a multiplier in [1, m].
+ */
+template<typename ItemFn>
+FamilyFunction spanner(ItemFn item, int v = 2, int m = 10) {
+    return [item, v, m](int n, int range, std::mt19937_64& rng) {
+        std::vector<Pallet> set;
+        for (int k = 0; k < v; k++) {
+            Pallet p = item(rng, range);
+            set.push_back({(2 * p.weight + m - 1) / m, (2 * p.profit + m - 1) / m});
+        }
+        std::vector<Pallet> pallets;
+        pallets.reserve(n);
+        for (int i = 0; i < n; i++) {
+            const Pallet& base = set[uniform(rng, 0, v - 1)];
+            int multiplier = (int)uniform(rng, 1, m);
+            pallets.push_back({base.weight * multiplier, base.profit * multiplier});
+        }
+        return pallets;
+    };
+}
+
+/**
+ * @brief Family of independent items drawn by one function.
+ */
+template<typename ItemFn>
+FamilyFunction independent(ItemFn item) {
+    return [item](int n, int range, std::mt19937_64& rng) {
+        std::vector<Pallet> pallets;
+        pallets.reserve(n);
+        for (int i = 0; i < n; i++) pallets.push_back(item(rng, range));
+        return pallets;
+    };
+}
+
+} // namespace
+
+// ====================================================================== //
+// ========================= INSTANCE FAMILIES ========================== //
+// ====================================================================== //
+
+const std::vector<InstanceFamily>& instanceFamilies() {
+    typedef std::mt19937_64 Rng;
+    static const std::vector<InstanceFamily> families = {
+        {"uncorrelated", "Uncorrelated", independent(uncorrelatedItem)},
+        {"weak", "Weakly correlated", independent(weaklyCorrelatedItem)},
+        {"strong", "Strongly correlated", independent(stronglyCorrelatedItem)},
+        {"inverse-strong", "Inverse strongly correlated", independent([](Rng& rng, int range) {
+            int profit = (int)uniform(rng, 1, range);
+            return Pallet{profit + range / 10, profit};
+        })},
+        {"almost-strong", "Almost strongly correlated", independent([](Rng& rng, int range) {
+            int weight = (int)uniform(rng, 1, range);
+            int center = weight + range / 10;
+            return Pallet{weight, (int)uniform(rng, std::max(1, center - range / 500), center + range / 500)};
+        })},
+        {"subset-sum", "Subset sum", independent([](Rng& rng, int range) {
+            int weight = (int)uniform(rng, 1, range);
+            return Pallet{weight, weight};
+        })},
+        {"uncorrelated-spanner", "Uncorrelated spanner(2, 10)", spanner(uncorrelatedItem)},
+        {"weak-spanner", "Weakly correlated spanner(2, 10)", spanner(weaklyCorrelatedItem)},
+        {"strong-spanner", "Strongly correlated spanner(2, 10)", spanner(stronglyCorrelatedItem)},
+        {"multiple-strong", "Multiple strongly correlated mstr(3R/10, 2R/10, 6)", independent([](Rng& rng, int range) {
+            int weight = (int)uniform(rng, 1, range);
+            return Pallet{weight, weight + (weight % 6 == 0 ? 3 * range / 10 : 2 * range / 10)};
+        })},
+        {"profit-ceiling", "Profit ceiling pc(3)", independent([](Rng& rng, int range) {
+            int weight = (int)uniform(rng, 1, range);
+            return Pallet{weight, 3 * ((weight + 2) / 3)};
+        })},
+        {"circle", "Circle(2/3)", independent([](Rng& rng, int range) {
+            int weight = (int)uniform(rng, 1, range);
+            double r = 2.0 * range, dx = weight - r;
+            return Pallet{weight, std::max(1, (int)std::lround(2.0 / 3.0 * std::sqrt(r * r - dx * dx)))};
+        })},
+    };
+    return families;
+}
+
+const InstanceFamily* findFamily(const std::string& key) {
+    for (const InstanceFamily& family : instanceFamilies()) {
+        if (family.key == key) return &family;
+    }
+    return nullptr;
+}
+
+// ====================================================================== //
+// ============================= GENERATION ============================= //
+// ====================================================================== //
+
+GeneratedInstance generateInstance(const GeneratorConfig& config) {
+    const InstanceFamily* family = findFamily(config.family);
+    if (!family) throw std::invalid_argument("unknown instance family " + config.family);
+    if (config.n < 1) throw std::invalid_argument("instance needs at least one pallet");
+    if (config.range < 2 || config.range > maxRange) {
+        throw std::invalid_argument("range must be between 2 and " + std::to_string(maxRange));
+    }
+
+    std::mt19937_64 rng(config.seed);
+    GeneratedInstance instance;
+    instance.label = config.family + "-n" + std::to_string(config.n) + "-r" + std::to_string(config.range) + "-s" +
+                     std::to_string(config.seed);
+    instance.pallets = family->generate(config.n, config.range, rng);
+
+    long long totalWeight = 0;
+    for (const Pallet& p : instance.pallets) totalWeight += p.weight;
+    double capacity = std::floor(config.capacityRatio * totalWeight);
+    instance.capacity = (int)std::min<double>(INT_MAX, std::max(1.0, capacity));
+    return instance;
+}
+
+void writeGeneratedInstance(const GeneratedInstance& instance, const std::string& path, int number) {
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0) {
+        writeBinaryInstance(path, instance.pallets, Truck{1, instance.capacity});
+        return;
+    }
+
+    fs::create_directories(path);
+    char ds[16];
+    std::snprintf(ds, sizeof(ds), "%02d", number);
+    fs::path palletsPath = fs::path(path) / ("Pallets_" + std::string(ds) + ".csv");
+    fs::path truckPath = fs::path(path) / ("TruckAndPallets_" + std::string(ds) + ".csv");
+
+    std::ofstream pallets(palletsPath);
+    pallets << "Pallet,Weight,Profit\n";
+    for (size_t i = 0; i < instance.pallets.size(); i++) {
+        pallets << i + 1 << ',' << instance.pallets[i].weight << ',' << instance.pallets[i].profit << '\n';
+    }
+    if (!pallets.flush()) throw std::runtime_error("cannot write " + palletsPath.string());
+
+    std::ofstream truck(truckPath);
+    truck << "Capacity,Pallets\n" << instance.capacity << ',' << instance.pallets.size() << '\n';
+    if (!truck.flush()) throw std::runtime_error("cannot write " + truckPath.string());
+}
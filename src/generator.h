@@ -0,0 +1,90 @@
+/**
+ * @file generator.h
+ * @brief Synthetic instances of the standard hard knapsack families.
+ *
+ * The families follow Pisinger, "Where are the hard knapsack problems?"
+ * (2005): weights are drawn uniformly from [1, R] and the profit is tied
+ * to the weight in a family-specific way. Instances are reproducible: the
+ * same GeneratorConfig gives the same pallets on every platform.
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "pallet.h"
+
+/**
+ * @struct GeneratorConfig
+ * @brief Parameters of a generated instance.
+ */
+struct GeneratorConfig {
+    std::string family = "uncorrelated";  ///< Key of an InstanceFamily
+    int n = 1000;                         ///< Number of pallets
+    int range = 1000;                     ///< R, weights are drawn from [1, R]
+    double capacityRatio = 0.5;           ///< Capacity as a fraction of the total weight
+    uint64_t seed = 1;                    ///< Seed of the generator
+};
+
+/**
+ * @struct GeneratedInstance
+ * @brief A generated instance with the label it is reported under.
+ */
+struct GeneratedInstance {
+    std::string label;           ///< e.g. "strong-n1000-r1000-s1"
+    std::vector<Pallet> pallets;
+    int capacity;
+};
+
+/// Draws the pallets of a family: (n, range, random engine)
+using FamilyFunction = std::function<std::vector<Pallet>(int, int, std::mt19937_64&)>;
+
+/**
+ * @struct InstanceFamily
+ * @brief A named instance family.
+ */
+struct InstanceFamily {
+    std::string key;           ///< Short identifier, e.g. "strong"
+    std::string name;          ///< Human-readable name
+    FamilyFunction generate;   ///< Draws the pallets
+};
+
+/**
+ * @brief Every family, in the order of the paper.
+ */
+const std::vector<InstanceFamily>& instanceFamilies();
+
+/**
+ * @brief Looks a family up by key.
+ * @return The family, or nullptr if no family has that key
+ */
+const InstanceFamily* findFamily(const std::string& key);
+
+/**
+ * @brief Generates an instance.
+ *
+ * The capacity is capacityRatio times the total weight, at least 1 and at
+ * most INT_MAX.
+ *
+ * @throws std::invalid_argument on an unknown family, n < 1 or range < 2
+ * @complexity Time: O(n)
+ */
+GeneratedInstance generateInstance(const GeneratorConfig& config);
+
+/**
+ * @brief Writes an instance in the format of the data directory.
+ *
+ * A path ending in ".bin" gets the binary format; otherwise the path is a
+ * directory that receives Pallets_XX.csv and TruckAndPallets_XX.csv, so the
+ * benchmark harness picks the instance up with --data.
+ *
+ * @param number Dataset number XX of the CSV pair
+ * @throws std::runtime_error if the output cannot be written
+ */
+void writeGeneratedInstance(const GeneratedInstance& instance, const std::string& path, int number = 1);
+
+#endif // GENERATOR_H
@@ -0,0 +1,107 @@
+/**
+ * @file instance.cpp
+ * @brief Instance orders and Solution conversions.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "binary.h"
+#include "instance.h"
+
+Instance::Instance(const std::vector<Pallet>& pallets, int capacity) : truckCapacity(capacity) {
+    weightArray.reserve(pallets.size());
+    profitArray.reserve(pallets.size());
+    for (const Pallet& pallet : pallets) {
+        weightArray.push_back(pallet.weight);
+        profitArray.push_back(pallet.profit);
+    }
+    computeTotals();
+}
+
+Instance::Instance(std::vector<int> weights, std::vector<int> profits, int capacity)
+    : weightArray(std::move(weights)), profitArray(std::move(profits)), truckCapacity(capacity) {
+    computeTotals();
+}
+
+Instance::Instance(const BinaryInstance& binary)
+    : Instance(std::vector<int>(binary.weights(), binary.weights() + binary.size()),
+               std::vector<int>(binary.profits(), binary.profits() + binary.size()), binary.capacity()) {}
+
+void Instance::computeTotals() {
+    size_t n = weightArray.size();
+    ratioArray.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        int weight = weightArray[i], profit = profitArray[i];
+        ratioArray[i] = weight > 0 ? (double)profit / weight
+                                   : (profit > 0 ? std::numeric_limits<double>::infinity() : 0.0);
+        weightSum += weight;
+        profitSum += profit;
+        if (profit > 0) positiveProfitSum += profit;
+    }
+}
+
+void Instance::sortByRatio() const {
+    std::call_once(ratioOnce, [this] {
+        int n = size();
+        const int* w = weights();
+        const int* p = profits();
+        RatioPrefix& rp = ratioSorted;
+        rp.order.resize(n);
+        for (int i = 0; i < n; i++) rp.order[i] = i;
+        // Weightless pallets have no ratio to cross-multiply: those that earn
+        // something go first (every load takes them), the others last (they
+        // never help). Equal ratios fall back to the index, so the order is
+        // strict and weightless pallets never sit next to the break item
+        // by accident of the sort.
+        auto group = [w, p](int i) { return w[i] > 0 ? 1 : (p[i] > 0 ? 0 : 2); };
+        std::sort(rp.order.begin(), rp.order.end(), [w, p, group](int a, int b) {
+            int ga = group(a), gb = group(b);
+            if (ga != gb) return ga < gb;
+            if (ga == 1) {
+                long long lhs = (long long)p[a] * w[b], rhs = (long long)p[b] * w[a];
+                if (lhs != rhs) return lhs > rhs;
+            }
+            return a < b;
+        });
+
+        rp.weight.assign(n + 1, 0);
+        rp.profit.assign(n + 1, 0);
+        for (int k = 0; k < n; k++) {
+            rp.weight[k + 1] = rp.weight[k] + w[rp.order[k]];
+            rp.profit[k + 1] = rp.profit[k] + p[rp.order[k]];
+            if (p[rp.order[k]] > 0) rp.positive = k + 1;
+        }
+        ratioReady.store(true, std::memory_order_release);
+    });
+}
+
+void Instance::sortByProfit() const {
+    std::call_once(profitOnce, [this] {
+        const int* w = weights();
+        const int* p = profits();
+        profitSorted.resize(size());
+        for (size_t i = 0; i < size(); i++) profitSorted[i] = i;
+        std::stable_sort(profitSorted.begin(), profitSorted.end(), [w, p](int a, int b) {
+            if (p[a] != p[b]) return p[a] > p[b];
+            return w[a] < w[b];
+        });
+        profitReady.store(true, std::memory_order_release);
+    });
+}
+
+std::vector<int> Solution::indices() const {
+    std::vector<int> result;
+    for (size_t word = 0; word < bits.size(); word++) {
+        for (uint64_t rest = bits[word]; rest; rest &= rest - 1) {
+            result.push_back(word * 64 + __builtin_ctzll(rest));
+        }
+    }
+    return result;
+}
+
+std::vector<Pallet> Solution::toPallets(const std::vector<Pallet>& pallets) const {
+    std::vector<Pallet> result(count, Pallet{0, 0});
+    for (int i : indices()) result[i] = pallets[i];
+    return result;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file instance.h
+ * @brief Shared instance storage and the compact solution type of the solvers.
+ */
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "pallet.h"
+
+class BinaryInstance;
+
+/**
+ * @struct RatioPrefix
+ * @brief Pallets in decreasing profit/weight order with prefix sums.
+ *
+ * Lets the fractional (Dantzig) bound of any suffix of the order be
+ * computed with one binary search instead of a linear scan.
+ */
+struct RatioPrefix {
+    std::vector<int> order;          ///< Pallet indices by decreasing profit/weight
+    std::vector<long long> weight;   ///< weight[k] = total weight of order[0..k)
+    std::vector<long long> profit;   ///< profit[k] = total profit of order[0..k)
+    int positive = 0;                ///< order[0..positive) are exactly the pallets with profit > 0
+};
+
+/**
+ * @class Instance
+ * @brief A knapsack instance in structure-of-arrays form, shared by every solver.
+ *
+ * Weights and profits sit in two contiguous arrays, so the solver loops
+ * stream 4 bytes per field instead of the whole 20-byte Pallet. The ratio
+ * order (with its prefix sums) and the profit order are sorted on first
+ * use and then kept, so running several engines on one instance sorts it
+ * once. The lazy orders are built under std::call_once and published with
+ * a flag, so concurrent solvers may share an instance and the accessors
+ * cost one load once built. Instances are neither copied nor moved.
+ */
+class Instance {
+public:
+    /**
+     * @brief Copies the weights and profits of the pallets.
+     * @complexity Time: O(n)
+     */
+    Instance(const std::vector<Pallet>& pallets, int capacity);
+
+    /**
+     * @brief Takes over weight and profit arrays of equal length.
+     * @complexity Time: O(n)
+     */
+    Instance(std::vector<int> weights, std::vector<int> profits, int capacity);
+
+    /**
+     * @brief Copies the mapped weight and profit columns of a binary instance.
+     *
+     * The columns are already in structure-of-arrays order, so no Pallet
+     * vector is built in between; the extra dimensions are not read.
+     *
+     * @complexity Time: O(n)
+     */
+    explicit Instance(const BinaryInstance& binary);
+
+    Instance(const Instance&) = delete;
+    Instance& operator=(const Instance&) = delete;
+
+    size_t size() const { return weightArray.size(); }
+    int capacity() const { return truckCapacity; }
+
+    int weight(size_t i) const { return weightArray[i]; }
+    int profit(size_t i) const { return profitArray[i]; }
+    const int* weights() const { return weightArray.data(); }
+    const int* profits() const { return profitArray.data(); }
+
+    /// profit / weight, +infinity for a weightless pallet that earns something
+    double ratio(size_t i) const { return ratioArray[i]; }
+
+    long long totalWeight() const { return weightSum; }
+    long long totalProfit() const { return profitSum; }
+
+    /// Sum of the positive profits: no load, and no DP cell, can exceed it
+    long long profitCeiling() const { return positiveProfitSum; }
+
+    /**
+     * @brief Pallets by decreasing profit/weight, ties in input order, with prefix sums.
+     *
+     * Ratios are compared by cross-multiplication, so the order is exact.
+     * Weightless pallets that earn something come first and the other
+     * weightless ones last, so the break item of any suffix has a weight.
+     *
+     * @complexity Time: O(n log n) on first use, O(1) after
+     */
+    const RatioPrefix& ratioPrefix() const {
+        if (!ratioReady.load(std::memory_order_acquire)) sortByRatio();
+        return ratioSorted;
+    }
+
+    /**
+     * @brief Pallets by decreasing profit, lighter first on equal profit.
+     * @complexity Time: O(n log n) on first use, O(1) after
+     */
+    const std::vector<int>& profitOrder() const {
+        if (!profitReady.load(std::memory_order_acquire)) sortByProfit();
+        return profitSorted;
+    }
+
+private:
+    void computeTotals();
+    void sortByRatio() const;
+    void sortByProfit() const;
+
+    std::vector<int> weightArray;
+    std::vector<int> profitArray;
+    std::vector<double> ratioArray;
+    long long weightSum = 0;
+    long long profitSum = 0;
+    long long positiveProfitSum = 0;
+    int truckCapacity;
+
+    mutable std::once_flag ratioOnce, profitOnce;
+    mutable std::atomic<bool> ratioReady{false}, profitReady{false};
+    mutable RatioPrefix ratioSorted;
+    mutable std::vector<int> profitSorted;
+};
+
+/**
+ * @class Solution
+ * @brief A load as one bit per pallet, with its totals.
+ *
+ * Replaces the pallet-aligned vector with {0, 0} placeholders: n / 8 bytes
+ * instead of 20 * n, and the totals need no second pass.
+ */
+class Solution {
+public:
+    Solution() = default;
+
+    /// Empty load over n pallets
+    explicit Solution(size_t n) : bits((n + 63) / 64, 0), count(n) {}
+
+    size_t size() const { return count; }
+    long long profit() const { return totalProfit; }
+    long long weight() const { return totalWeight; }
+
+    bool taken(size_t i) const { return (bits[i >> 6] >> (i & 63)) & 1; }
+
+    /**
+     * @brief Adds a pallet to the load; adding it twice has no effect.
+     */
+    void take(size_t i, long long weight, long long profit) {
+        if (taken(i)) return;
+        bits[i >> 6] |= (uint64_t)1 << (i & 63);
+        totalWeight += weight;
+        totalProfit += profit;
+    }
+
+    void take(const Instance& instance, size_t i) { take(i, instance.weight(i), instance.profit(i)); }
+
+    /// Indices of the pallets taken, increasing
+    std::vector<int> indices() const;
+
+    /**
+     * @brief The load in the pallet-aligned form: pallets[i] if taken, {0, 0} otherwise.
+     * @complexity Time: O(n)
+     */
+    std::vector<Pallet> toPallets(const std::vector<Pallet>& pallets) const;
+
+private:
+    std::vector<uint64_t> bits;
+    size_t count = 0;
+    long long totalProfit = 0;
+    long long totalWeight = 0;
+};
+
+#endif // INSTANCE_H
@@ -0,0 +1,323 @@
+/**
+ * @file kernels.cpp
+ * @brief Scalar, SSE4.1 and AVX2 implementations of the knapsack DP row update.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// ====================================================================== //
+// ============================ ALIGNED ROWS ============================ //
+// ====================================================================== //
+
+AlignedRow::AlignedRow(size_t bytes) {
+    // aligned_alloc needs the size to be a multiple of the alignment
+    bytes = (bytes + 31) / 32 * 32;
+    values = std::aligned_alloc(32, bytes ? bytes : 32);
+    if (!values) throw std::bad_alloc();
+    std::memset(values, 0, bytes);
+    allocated = bytes;
+}
+
+AlignedRow::~AlignedRow() {
+    std::free(values);
+}
+
+void AlignedRow::zero(size_t bytes) {
+    if (bytes > allocated) {
+        size_t rounded = (bytes + 31) / 32 * 32;
+        void* grown = std::aligned_alloc(32, rounded);
+        if (!grown) throw std::bad_alloc();
+        std::free(values);
+        values = grown;
+        allocated = rounded;
+    }
+    std::memset(values, 0, bytes);
+}
+
+// ====================================================================== //
+// =========================== SCALAR KERNEL ============================ //
+// ====================================================================== //
+
+/**
+ * @brief Updates one capacity cell; the prologue and epilogue of every kernel.
+ */
+template <typename Value>
+inline void knapsackCell(const Value* prev, Value* cur, uint64_t* bits, int j, int weight, Value profit) {
+    Value candidate = prev[j - weight] + profit;
+    bool take = candidate > prev[j];
+    cur[j] = take ? candidate : prev[j];
+    if (take) bits[j >> 6] |= (uint64_t)1 << (j & 63);
+}
+
+/**
+ * @brief Copies the cells below the pallet weight, which cannot take it.
+ * @return First cell that may take the pallet
+ */
+template <typename Value>
+inline int copyUnreachable(const Value* prev, Value* cur, int first, int last, int weight) {
+    int split = std::max(first, std::min(weight, last + 1));
+    std::memcpy(cur + first, prev + first, (split - first) * sizeof(Value));
+    return split;
+}
+
+/**
+ * @brief Portable row kernel, one capacity cell per iteration.
+ *
+ * @complexity Time: O(last - first)
+ */
+template <typename Value>
+void knapsackRowScalar(const Value* prev, Value* cur, uint64_t* bits,
+                       int first, int last, int weight, Value profit) {
+    for (int j = copyUnreachable(prev, cur, first, last, weight); j <= last; j++) {
+        knapsackCell(prev, cur, bits, j, weight, profit);
+    }
+}
+
+#ifdef KERNELS_X86
+
+// ====================================================================== //
+// ============================= SIMD LANES ============================= //
+// ====================================================================== //
+
+// Each lane set wraps the instructions of one register width and cell
+// type. update() returns max(old, candidate) and sets one bit of wins per
+// lane where candidate strictly wins. Unsigned 16 and 32-bit cells have
+// no greater-than compare, so a lane wins where the maximum differs from
+// the old value. 64-bit cells stay below 2^63 (n int profits), so the
+// signed compare of AVX2 is exact.
+
+#define SSE41 __attribute__((target("sse4.1")))
+#define AVX2 __attribute__((target("avx2")))
+
+struct SSE41Lanes16 {
+    typedef uint16_t Value;
+    typedef __m128i Vector;
+    static const int count = 8;
+
+    SSE41 static Vector broadcast(Value v) { return _mm_set1_epi16((short)v); }
+    SSE41 static Vector load(const Value* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE41 static Vector loadu(const Value* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE41 static void store(Value* p, Vector v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    SSE41 static Vector add(Vector a, Vector b) { return _mm_add_epi16(a, b); }
+    SSE41 static Vector update(Vector old, Vector candidate, unsigned& wins) {
+        Vector best = _mm_max_epu16(old, candidate);
+        Vector same = _mm_cmpeq_epi16(best, old);
+        wins = ~(unsigned)_mm_movemask_epi8(_mm_packs_epi16(same, _mm_setzero_si128())) & 0xFF;
+        return best;
+    }
+};
+
+struct SSE41Lanes32 {
+    typedef uint32_t Value;
+    typedef __m128i Vector;
+    static const int count = 4;
+
+    SSE41 static Vector broadcast(Value v) { return _mm_set1_epi32((int)v); }
+    SSE41 static Vector load(const Value* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE41 static Vector loadu(const Value* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE41 static void store(Value* p, Vector v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    SSE41 static Vector add(Vector a, Vector b) { return _mm_add_epi32(a, b); }
+    SSE41 static Vector update(Vector old, Vector candidate, unsigned& wins) {
+        Vector best = _mm_max_epu32(old, candidate);
+        Vector same = _mm_cmpeq_epi32(best, old);
+        wins = ~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(same)) & 0xF;
+        return best;
+    }
+};
+
+struct AVX2Lanes16 {
+    typedef uint16_t Value;
+    typedef __m256i Vector;
+    static const int count = 16;
+
+    AVX2 static Vector broadcast(Value v) { return _mm256_set1_epi16((short)v); }
+    AVX2 static Vector load(const Value* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static Vector loadu(const Value* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static void store(Value* p, Vector v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    AVX2 static Vector add(Vector a, Vector b) { return _mm256_add_epi16(a, b); }
+    AVX2 static Vector update(Vector old, Vector candidate, unsigned& wins) {
+        Vector best = _mm256_max_epu16(old, candidate);
+        Vector same = _mm256_cmpeq_epi16(best, old);
+        // Packing the two 128-bit halves keeps the lanes in order, one byte each
+        __m128i bytes = _mm_packs_epi16(_mm256_castsi256_si128(same), _mm256_extracti128_si256(same, 1));
+        wins = ~(unsigned)_mm_movemask_epi8(bytes) & 0xFFFF;
+        return best;
+    }
+};
+
+struct AVX2Lanes32 {
+    typedef uint32_t Value;
+    typedef __m256i Vector;
+    static const int count = 8;
+
+    AVX2 static Vector broadcast(Value v) { return _mm256_set1_epi32((int)v); }
+    AVX2 static Vector load(const Value* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static Vector loadu(const Value* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static void store(Value* p, Vector v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    AVX2 static Vector add(Vector a, Vector b) { return _mm256_add_epi32(a, b); }
+    AVX2 static Vector update(Vector old, Vector candidate, unsigned& wins) {
+        Vector best = _mm256_max_epu32(old, candidate);
+        Vector same = _mm256_cmpeq_epi32(best, old);
+        wins = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(same)) & 0xFF;
+        return best;
+    }
+};
+
+struct AVX2Lanes64 {
+    typedef uint64_t Value;
+    typedef __m256i Vector;
+    static const int count = 4;
+
+    AVX2 static Vector broadcast(Value v) { return _mm256_set1_epi64x((long long)v); }
+    AVX2 static Vector load(const Value* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static Vector loadu(const Value* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static void store(Value* p, Vector v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    AVX2 static Vector add(Vector a, Vector b) { return _mm256_add_epi64(a, b); }
+    AVX2 static Vector update(Vector old, Vector candidate, unsigned& wins) {
+        Vector greater = _mm256_cmpgt_epi64(candidate, old);
+        wins = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(greater));
+        return _mm256_blendv_epi8(old, candidate, greater);
+    }
+};
+
+// ====================================================================== //
+// ============================ SIMD KERNELS ============================ //
+// ====================================================================== //
+
+/**
+ * @brief SSE4.1 row kernel, 16 bytes of cells per iteration.
+ *
+ * Cells below the pallet weight are copied, a scalar prologue reaches an
+ * index aligned to the register width, and the wins of each block are
+ * written straight into the decision bits. The block never crosses a
+ * bits word, since the lane count divides 64.
+ *
+ * @complexity Time: O((last - first) / Lanes::count)
+ */
+template <typename Lanes>
+SSE41 void knapsackRowSSE41(const typename Lanes::Value* prev, typename Lanes::Value* cur, uint64_t* bits,
+                            int first, int last, int weight, typename Lanes::Value profit) {
+    typedef typename Lanes::Vector Vector;
+    const int count = Lanes::count;
+
+    int j = copyUnreachable(prev, cur, first, last, weight);
+    for (; j <= last && (j & (count - 1)); j++) knapsackCell(prev, cur, bits, j, weight, profit);
+
+    const Vector add = Lanes::broadcast(profit);
+    for (; j + count - 1 <= last; j += count) {
+        Vector old = Lanes::load(prev + j);
+        Vector candidate = Lanes::add(Lanes::loadu(prev + j - weight), add);
+        unsigned wins;
+        Lanes::store(cur + j, Lanes::update(old, candidate, wins));
+        if (wins) bits[j >> 6] |= (uint64_t)wins << (j & 63);
+    }
+
+    for (; j <= last; j++) knapsackCell(prev, cur, bits, j, weight, profit);
+}
+
+/**
+ * @brief AVX2 row kernel, 32 bytes of cells per iteration.
+ *
+ * Same structure as the SSE4.1 kernel with 256-bit registers.
+ *
+ * @complexity Time: O((last - first) / Lanes::count)
+ */
+template <typename Lanes>
+AVX2 void knapsackRowAVX2(const typename Lanes::Value* prev, typename Lanes::Value* cur, uint64_t* bits,
+                          int first, int last, int weight, typename Lanes::Value profit) {
+    typedef typename Lanes::Vector Vector;
+    const int count = Lanes::count;
+
+    int j = copyUnreachable(prev, cur, first, last, weight);
+    for (; j <= last && (j & (count - 1)); j++) knapsackCell(prev, cur, bits, j, weight, profit);
+
+    const Vector add = Lanes::broadcast(profit);
+    for (; j + count - 1 <= last; j += count) {
+        Vector old = Lanes::load(prev + j);
+        Vector candidate = Lanes::add(Lanes::loadu(prev + j - weight), add);
+        unsigned wins;
+        Lanes::store(cur + j, Lanes::update(old, candidate, wins));
+        if (wins) bits[j >> 6] |= (uint64_t)wins << (j & 63);
+    }
+
+    for (; j <= last; j++) knapsackCell(prev, cur, bits, j, weight, profit);
+}
+
+#undef SSE41
+#undef AVX2
+
+#endif // KERNELS_X86
+
+// ====================================================================== //
+// ========================== KERNEL SELECTION ========================== //
+// ====================================================================== //
+
+/**
+ * @brief SIMD kernels of one cell type the running CPU can execute, fastest first.
+ *
+ * 64-bit cells have no SSE4.1 kernel: their signed compare needs SSE4.2
+ * and beats the scalar loop only with four lanes.
+ */
+template <typename Value>
+void addSimdKernels(std::vector<KnapsackKernel<Value>>& list);
+
+template <>
+void addSimdKernels(std::vector<KnapsackKernel<uint16_t>>& list) {
+#ifdef KERNELS_X86
+    if (__builtin_cpu_supports("avx2")) list.push_back({"avx2", knapsackRowAVX2<AVX2Lanes16>});
+    if (__builtin_cpu_supports("sse4.1")) list.push_back({"sse4.1", knapsackRowSSE41<SSE41Lanes16>});
+#endif
+    (void)list;
+}
+
+template <>
+void addSimdKernels(std::vector<KnapsackKernel<uint32_t>>& list) {
+#ifdef KERNELS_X86
+    if (__builtin_cpu_supports("avx2")) list.push_back({"avx2", knapsackRowAVX2<AVX2Lanes32>});
+    if (__builtin_cpu_supports("sse4.1")) list.push_back({"sse4.1", knapsackRowSSE41<SSE41Lanes32>});
+#endif
+    (void)list;
+}
+
+template <>
+void addSimdKernels(std::vector<KnapsackKernel<uint64_t>>& list) {
+#ifdef KERNELS_X86
+    if (__builtin_cpu_supports("avx2")) list.push_back({"avx2", knapsackRowAVX2<AVX2Lanes64>});
+#endif
+    (void)list;
+}
+
+template <typename Value>
+const std::vector<KnapsackKernel<Value>>& availableKnapsackKernels() {
+    static const std::vector<KnapsackKernel<Value>> kernels = [] {
+        std::vector<KnapsackKernel<Value>> list;
+#ifdef KERNELS_X86
+        __builtin_cpu_init();
+#endif
+        addSimdKernels(list);
+        list.push_back({"scalar", knapsackRowScalar<Value>});
+        return list;
+    }();
+    return kernels;
+}
+
+template <typename Value>
+const KnapsackKernel<Value>& bestKnapsackKernel() {
+    return availableKnapsackKernels<Value>().front();
+}
+
+template const std::vector<KnapsackKernel<uint16_t>>& availableKnapsackKernels<uint16_t>();
+template const std::vector<KnapsackKernel<uint32_t>>& availableKnapsackKernels<uint32_t>();
+template const std::vector<KnapsackKernel<uint64_t>>& availableKnapsackKernels<uint64_t>();
+template const KnapsackKernel<uint16_t>& bestKnapsackKernel<uint16_t>();
+template const KnapsackKernel<uint32_t>& bestKnapsackKernel<uint32_t>();
+template const KnapsackKernel<uint64_t>& bestKnapsackKernel<uint64_t>();
@@ -0,0 +1,105 @@
+/**
+ * @file kernels.h
+ * @brief Row kernels for the 0/1 knapsack dynamic programming, with SIMD variants.
+ */
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Signature of a kernel computing a range of one row of the knapsack DP.
+ *
+ * For every j in [first, last] the kernel stores
+ * cur[j] = max(prev[j], prev[j - weight] + profit), the second term only
+ * when j >= weight, and sets bit j of bits whenever it strictly wins.
+ * bits must be zeroed beforehand and cover index last.
+ * prev and cur must be 32-byte aligned. Ranges that start on a multiple
+ * of 64 never share a bits word, so they can be filled concurrently.
+ * Values never wrap: the caller picks a Value wide enough for the
+ * largest cell (see knapsackValueBits()) and passes non-negative profits.
+ *
+ * @tparam Value Cell type: uint16_t, uint32_t or uint64_t
+ */
+template <typename Value>
+using KnapsackRowKernel = void (*)(const Value* prev, Value* cur, uint64_t* bits,
+                                   int first, int last, int weight, Value profit);
+
+/**
+ * @struct KnapsackKernel
+ * @brief A named row kernel, used to report and benchmark the selected instruction set.
+ */
+template <typename Value>
+struct KnapsackKernel {
+    const char* name;               ///< Instruction set name ("avx2", "sse4.1" or "scalar")
+    KnapsackRowKernel<Value> row;   ///< The row kernel itself
+};
+
+/**
+ * @brief Returns the fastest kernel for Value supported by the running CPU.
+ *
+ * CPU features are detected once, on the first call. Instantiated for
+ * uint16_t, uint32_t and uint64_t.
+ */
+template <typename Value>
+const KnapsackKernel<Value>& bestKnapsackKernel();
+
+/**
+ * @brief Lists every kernel for Value the running CPU can execute, fastest first.
+ */
+template <typename Value>
+const std::vector<KnapsackKernel<Value>>& availableKnapsackKernels();
+
+/**
+ * @brief Narrowest DP cell width, in bits, that holds values up to ceiling.
+ *
+ * 16-bit cells fill twice as many SIMD lanes as 32-bit ones and halve
+ * the rows; 64-bit cells take the instances whose profits would
+ * overflow 32 bits.
+ *
+ * @param ceiling Largest value a cell can reach, e.g. Instance::profitCeiling()
+ * @return 16, 32 or 64
+ */
+inline int knapsackValueBits(long long ceiling) {
+    if (ceiling <= UINT16_MAX) return 16;
+    if (ceiling <= (long long)UINT32_MAX) return 32;
+    return 64;
+}
+
+/**
+ * @brief Heap buffer aligned for the widest SIMD loads, viewed as rows of any cell type.
+ */
+class AlignedRow {
+public:
+    explicit AlignedRow(size_t bytes);
+    ~AlignedRow();
+    AlignedRow(const AlignedRow&) = delete;
+    AlignedRow& operator=(const AlignedRow&) = delete;
+
+    /**
+     * @brief Zeroes the first count values of type Value, reallocating only when they do not fit.
+     * @return The buffer as an array of Value
+     */
+    template <typename Value>
+    Value* reset(size_t count) {
+        zero(count * sizeof(Value));
+        return data<Value>();
+    }
+
+    template <typename Value>
+    Value* data() { return static_cast<Value*>(values); }
+
+    template <typename Value>
+    const Value* data() const { return static_cast<const Value*>(values); }
+
+private:
+    void zero(size_t bytes);
+
+    void* values;
+    size_t allocated;  ///< Number of bytes the buffer can hold
+};
+
+#endif // KERNELS_H
@@ -3,16 +3,27 @@
  * @brief Entry point for the Delivery Truck Pallet Packing Optimization project with enhanced CLI and tabular results.
  */
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <string>
 #include <vector>
 #include "algorithms.h"
 #include "parser.h"
+#include "batch.h"
+#include "binary.h"
 #include "benchmark.h"
+#include "fleet.h"
+#include "generator.h"
+#include "multidim.h"
+#include "session.h"
+#include "solver.h"
 
 namespace fs = std::filesystem;
 
@@ -56,7 +67,386 @@ static bool validateFile(const std::string &path) {
     return true;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Subcommand: convert CSV instances to the binary format
+    if (argc >= 2 && std::string(argv[1]) == "convert") {
+        try {
+            if (argc == 5) {
+                convertCSVToBinary(argv[2], argv[3], argv[4]);
+                std::cout << "Wrote " << argv[4] << "\n";
+            } else if (argc == 3 || argc == 4) {
+                std::string outputDir = argc == 4 ? argv[3] : argv[2];
+                int converted = convertDatasetDirectory(argv[2], outputDir);
+                std::cout << "Wrote " << converted << " instances to " << outputDir << "\n";
+            } else {
+                std::cout << "Usage: " << argv[0] << " convert PALLETS TRUCK OUTPUT\n"
+                          << "       " << argv[0] << " convert DATA_DIR [OUTPUT_DIR]\n";
+                return 1;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Subcommand: write a synthetic instance of a standard family
+    if (argc >= 2 && std::string(argv[1]) == "generate") {
+        GeneratorConfig config;
+        std::vector<std::string> positional;
+        int number = 1;
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--range" && i + 1 < argc) {
+                config.range = std::atoi(argv[++i]);
+            } else if (arg == "--ratio" && i + 1 < argc) {
+                config.capacityRatio = std::atof(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                config.seed = std::strtoull(argv[++i], nullptr, 10);
+            } else if (arg == "--number" && i + 1 < argc) {
+                number = std::max(0, std::atoi(argv[++i]));
+            } else {
+                positional.push_back(arg);
+            }
+        }
+        if (positional.size() != 3) {
+            std::cout << "Usage: " << argv[0] << " generate FAMILY N OUTPUT [--range R] [--ratio F] [--seed S]"
+                      << " [--number XX]\n"
+                      << "OUTPUT is a directory for Pallets_XX.csv / TruckAndPallets_XX.csv, or a .bin file\n"
+                      << "Families:";
+            for (const InstanceFamily& family : instanceFamilies()) std::cout << ' ' << family.key;
+            std::cout << "\n";
+            return 1;
+        }
+        try {
+            config.family = positional[0];
+            config.n = std::stoi(positional[1]);
+            GeneratedInstance instance = generateInstance(config);
+            writeGeneratedInstance(instance, positional[2], number);
+            std::cout << "Wrote " << instance.label << " (capacity " << instance.capacity << ") to "
+                      << positional[2] << "\n";
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Worker threads for the parallel engines (0 = all hardware threads)
+    int threads = 0;
+    std::string manifestPath, outputPath, engine = "auto";
+    std::string fleetPallets, fleetTrucks, multiPallets, multiTruck;
+    bool fleetExact = false;
+    int sessionCapacity = -1;
+    long long parseRows = -1;
+    bool bench = false;
+    BenchmarkConfig benchConfig;
+    GeneratorConfig genConfig;
+    std::vector<int> genSizes;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--batch" && i + 1 < argc) {
+            manifestPath = argv[++i];
+        } else if (arg == "--engine" && i + 1 < argc) {
+            engine = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--fleet" && i + 2 < argc) {
+            fleetPallets = argv[++i];
+            fleetTrucks = argv[++i];
+        } else if (arg == "--multidim" && i + 2 < argc) {
+            multiPallets = argv[++i];
+            multiTruck = argv[++i];
+        } else if (arg == "--session" && i + 1 < argc) {
+            sessionCapacity = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--parse-bench" && i + 1 < argc) {
+            parseRows = std::max(1LL, std::atoll(argv[++i]));
+        } else if (arg == "--exact") {
+            fleetExact = true;
+        } else if (arg == "--bench") {
+            bench = true;
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            benchConfig.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--reps" && i + 1 < argc) {
+            benchConfig.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            benchConfig.timeoutSec = std::max(0.001, std::atof(argv[++i]));
+        } else if (arg == "--memory" && i + 1 < argc) {
+            benchConfig.memoryLimitMb = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--counters") {
+            benchConfig.counters = true;
+        } else if (arg == "--scaling") {
+            benchConfig.scaling = true;
+        } else if (arg == "--algo" && i + 1 < argc) {
+            std::istringstream keys(argv[++i]);
+            std::string key;
+            while (std::getline(keys, key, ',')) {
+                if (!findSolver(key)) {
+                    std::cerr << "Unknown engine: " << key << "\n";
+                    return 1;
+                }
+                benchConfig.algorithms.push_back(key);
+            }
+        } else if (arg == "--dataset" && i + 1 < argc) {
+            try {
+                benchConfig.datasets = parseNumberList(argv[++i]);
+            } catch (const std::exception &) {
+                std::cerr << "Error: bad dataset list " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--gen" && i + 1 < argc) {
+            genConfig.family = argv[++i];
+            if (!findFamily(genConfig.family)) {
+                std::cerr << "Unknown instance family: " << genConfig.family << "\n";
+                return 1;
+            }
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            try {
+                genSizes = parseNumberList(argv[++i]);
+            } catch (const std::exception &) {
+                std::cerr << "Error: bad size list " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--range" && i + 1 < argc) {
+            genConfig.range = std::atoi(argv[++i]);
+        } else if (arg == "--ratio" && i + 1 < argc) {
+            genConfig.capacityRatio = std::atof(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            genConfig.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--data" && i + 1 < argc) {
+            benchConfig.dataDir = argv[++i];
+        } else if (arg == "--csv" && i + 1 < argc) {
+            benchConfig.csvPath = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            benchConfig.jsonPath = argv[++i];
+        } else {
+            std::cout << "Unknown option: " << arg << "\n"
+                      << "Usage: " << argv[0] << " [--threads N]"
+                      << " [--batch MANIFEST [--engine KEY] [--output FILE]]"
+                      << " [--fleet PALLETS TRUCKS [--engine KEY] [--exact]]"
+                      << " [--multidim PALLETS TRUCK [--exact]]"
+                      << " [--session CAPACITY] [--parse-bench ROWS]\n"
+                      << "       " << argv[0] << " --bench [--algo KEY[,KEY...]] [--dataset LIST] [--data DIR]"
+                      << " [--warmup N] [--reps N] [--timeout SEC] [--memory MB] [--counters] [--scaling]"
+                      << " [--csv FILE] [--json FILE]"
+                      << " [--gen FAMILY --sizes LIST [--range R] [--ratio F] [--seed S]]\n"
+                      << "       " << argv[0] << " generate FAMILY N OUTPUT [--range R] [--ratio F] [--seed S]\n"
+                      << "       " << argv[0] << " convert PALLETS TRUCK OUTPUT | DATA_DIR [OUTPUT_DIR]\n";
+            return 1;
+        }
+    }
+
+    // Benchmark mode: statistical runs of the registry engines, no menus
+    if (bench) {
+        benchConfig.threads = threads;
+        for (int n : genSizes) {
+            genConfig.n = n;
+            benchConfig.generated.push_back(genConfig);
+        }
+        std::vector<BenchmarkResult> results;
+        try {
+            results = runBenchmarks(benchConfig);
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout << std::left << std::setw(36) << "Algorithm" << std::setw(28) << "Instance" << std::right
+                  << std::setw(12) << "Median(s)" << std::setw(12) << "P95(s)" << std::setw(12) << "StdDev(s)"
+                  << std::setw(12) << "PeakRSS(kB)" << std::setw(14) << "Nodes/s" << "\n";
+        for (const BenchmarkResult &r : results) {
+            std::cout << std::left << std::setw(36) << r.algorithm << std::setw(28) << r.instance << std::right;
+            if (r.status == "ok") {
+                std::cout << std::fixed << std::setprecision(6) << std::setw(12) << r.median << std::setw(12)
+                          << r.p95 << std::setw(12) << r.stddev;
+            } else {
+                std::cout << std::setw(36) << r.status;
+            }
+            std::cout << std::setw(12) << r.peakRssKb << std::setw(14);
+            if (r.nodesPerSecond >= 0) {
+                std::cout << std::scientific << std::setprecision(3) << r.nodesPerSecond;
+                std::cout.unsetf(std::ios::floatfield);
+            } else {
+                std::cout << "-";
+            }
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    // Batch mode: solve every load of the manifest, no menus
+    if (!manifestPath.empty()) {
+        const Solver* solver = findSolver(engine);
+        if (!solver) {
+            std::cerr << "Unknown engine: " << engine << "\nAvailable:";
+            for (const Solver& s : solverRegistry()) std::cerr << ' ' << s.key;
+            std::cerr << "\n";
+            return 1;
+        }
+
+        std::vector<BatchJob> jobs;
+        try {
+            jobs = parseManifest(manifestPath);
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+
+        std::ofstream file;
+        if (!outputPath.empty()) {
+            file.open(outputPath);
+            if (!file) {
+                std::cerr << "Error: cannot write " << outputPath << "\n";
+                return 1;
+            }
+        }
+        BatchSummary summary = runBatch(jobs, *solver, SolveOptions(), threads,
+                                        outputPath.empty() ? std::cout : file);
+        std::cerr << summary.solved << " solved, " << summary.failed << " failed in "
+                  << std::fixed << std::setprecision(3) << summary.seconds << "s\n";
+        return summary.failed == 0 ? 0 : 2;
+    }
+
+    // Fleet mode: one pool of pallets shared by several trucks
+    if (!fleetPallets.empty()) {
+        const Solver* solver = findSolver(engine);
+        if (!solver) {
+            std::cerr << "Unknown engine: " << engine << "\n";
+            return 1;
+        }
+        std::vector<Pallet> pallets;
+        std::vector<Truck> trucks;
+        try {
+            pallets = parsePalletsCSV(fleetPallets);
+            trucks = parseTrucksCSV(fleetTrucks);
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        if (trucks.empty()) {
+            std::cerr << "Error: no trucks in " << fleetTrucks << "\n";
+            return 1;
+        }
+
+        SolveOptions options;
+        options.threads = threads;
+        auto start = std::chrono::steady_clock::now();
+        FleetResult fleet = fleetExact ? fleetBranchAndBound(pallets, trucks, options)
+                                       : fleetHeuristic(pallets, trucks, options, solver);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long long loadedWeight = 0;
+        for (size_t t = 0; t < trucks.size(); t++) {
+            long long weight = 0, profit = 0;
+            std::string ids;
+            for (size_t i = 0; i < pallets.size(); i++) {
+                if (fleet.truckOf[i] != (int)t) continue;
+                weight += pallets[i].weight;
+                profit += pallets[i].profit;
+                ids += ' ' + std::to_string(i + 1);
+            }
+            loadedWeight += weight;
+            std::cout << "Truck " << trucks[t].id << ": " << weight << "/" << trucks[t].capacity
+                      << " weight, profit " << profit << ", pallets" << (ids.empty() ? " none" : ids) << "\n";
+        }
+        std::cout << "Total profit: " << fleet.profit << ", weight: " << loadedWeight << "\n"
+                  << "Status: " << (fleet.optimal ? "Optimal" : "Approximate");
+        if (fleet.upperBound >= 0) std::cout << " (upper bound " << fleet.upperBound << ")";
+        std::cout << "\nTime: " << std::fixed << std::setprecision(3) << seconds << "s\n";
+        return 0;
+    }
+
+    // Parser microbenchmark
+    if (parseRows > 0) {
+        runParseBenchmark(parseRows);
+        return 0;
+    }
+
+    // Session mode: re-plan after each change read from stdin
+    if (sessionCapacity >= 0) {
+        PackingSession session(sessionCapacity);
+        std::cout << "Commands: add WEIGHT PROFIT | remove ID | capacity C | solve | quit\n";
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            std::istringstream ss(line);
+            std::string command;
+            if (!(ss >> command)) continue;
+            if (command == "quit") break;
+
+            int a = 0, b = 0;
+            if (command == "add" && ss >> a >> b) {
+                std::cout << "Added pallet " << session.addPallet(Pallet{a, b}) << "\n";
+            } else if (command == "remove" && ss >> a) {
+                std::cout << (session.removePallet(a) ? "Removed pallet " : "No pallet ") << a << "\n";
+            } else if (command == "capacity" && ss >> a) {
+                session.setCapacity(a);
+                std::cout << "Capacity " << session.capacity() << "\n";
+            } else if (command == "solve") {
+                auto start = std::chrono::steady_clock::now();
+                SolveResult solved = session.solve();
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                std::string ids;
+                for (int i : solved.solution.indices()) ids += ' ' + std::to_string(session.ids()[i]);
+                std::cout << "Load:" << (ids.empty() ? " none" : ids) << "\n"
+                          << "Profit: " << solved.solution.profit() << ", weight: " << solved.solution.weight()
+                          << "/" << session.capacity()
+                          << " (" << solved.engine << ", " << std::fixed << std::setprecision(3) << ms << " ms)\n";
+                std::cout.unsetf(std::ios::fixed);
+            } else {
+                std::cout << "Unknown command: " << line << "\n";
+            }
+        }
+        return 0;
+    }
+
+    // Multi-dimensional mode: weight, volume, floor slots and axle limits of one truck
+    if (!multiPallets.empty()) {
+        std::vector<Pallet> pallets;
+        std::vector<Truck> trucks;
+        try {
+            pallets = parsePalletsCSV(multiPallets);
+            trucks = parseTrucksCSV(multiTruck);
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        if (trucks.empty()) {
+            std::cerr << "Error: no truck in " << multiTruck << "\n";
+            return 1;
+        }
+        const Truck &truck = trucks[0];
+
+        SolveOptions options;
+        options.threads = threads;
+        auto start = std::chrono::steady_clock::now();
+        SolveResult solved = multiDimensionalSolve(pallets, truck, options, fleetExact);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long long profit = 0, weight = 0, volume = 0, slots = 0, front = 0;
+        std::string ids;
+        for (int i : solved.solution.indices()) {
+            profit += pallets[i].profit;
+            weight += pallets[i].weight;
+            volume += pallets[i].volume;
+            slots += pallets[i].slots;
+            front += pallets[i].frontAxle;
+            ids += ' ' + std::to_string(i + 1);
+        }
+        auto limit = [](int value) { return value < 0 ? std::string("-") : std::to_string(value); };
+        std::cout << "Engine: " << solved.engine << "\n"
+                  << "Pallets:" << (ids.empty() ? " none" : ids) << "\n"
+                  << "Profit: " << profit << "\n"
+                  << "Weight: " << weight << "/" << truck.capacity
+                  << ", volume: " << volume << "/" << limit(truck.volume)
+                  << ", slots: " << slots << "/" << limit(truck.slots)
+                  << ", front axle: " << front << "/" << limit(truck.frontAxle)
+                  << ", rear axle: " << weight - front << "/" << limit(truck.rearAxle) << "\n"
+                  << "Status: " << (solved.optimal ? "Optimal" : "Approximate") << "\n"
+                  << "Time: " << std::fixed << std::setprecision(3) << seconds << "s\n";
+        return 0;
+    }
+
     std::cout << "=== Delivery Truck Pallet Packing Optimization Tool ===\n";
     std::cout << "Solve the 0/1 Knapsack problem using various algorithms.\n";
     
@@ -91,7 +481,11 @@ int main() {
             } while (!validateFile(truckPath));
         }
         else if (selection == "b") {
-            runBenchmarks();
+            BenchmarkConfig config;
+            config.threads = threads;
+            config.datasets = parseNumberList("1-10");
+            config.scaling = true;
+            runBenchmarks(config);
             std::cout << "Benchmark data saved to benchmark.csv\n";
             return 0;
         }
@@ -112,29 +506,59 @@ int main() {
         }
 
         // choose algorithm
-        std::cout << "\nSelect algorithm:\n"
-                  << " [1] Exhaustive Search\n"
-                  << " [2] Backtracking\n"
-                  << " [3] Dynamic Programming\n"
-                  << " [4] Approximation\n"
-                  << " [5] Integer Linear Programming\n";
-        int algo = promptNumber("Enter choice (1-5): ", 1, 5);
+        const std::vector<Solver>& solvers = solverRegistry();
+        std::cout << "\nSelect algorithm:\n";
+        for (size_t i = 0; i < solvers.size(); i++) {
+            std::cout << " [" << (i + 1) << "] " << solvers[i].name << "\n";
+        }
+        int count = solvers.size();
+        int algo = promptNumber("Enter choice (1-" + std::to_string(count) + "): ", 1, count);
+        const Solver& solver = solvers[algo - 1];
+
+        SolveOptions options;
+        options.threads = threads;
+        options.log = &std::cout;
+
+        double epsilon = 0.1;
+        if (solver.key == "fptas") {
+            std::string input = promptLine("Enter epsilon, 0 < e < 1 [0.1]: ");
+            try {
+                epsilon = std::stod(input);
+            } catch (const std::exception &) {
+                epsilon = 0.1;
+            }
+            if (epsilon <= 0 || epsilon >= 1) {
+                std::cout << "Epsilon out of range, using 0.1.\n";
+                epsilon = 0.1;
+            }
+        }
+
+        options.epsilon = epsilon;
+
+        if (solver.key == "anytime" || solver.key == "auto") {
+            int defaultMs = solver.key == "anytime" ? 100 : 0;
+            std::string input = promptLine("Enter time budget in milliseconds, 0 = none [" +
+                                           std::to_string(defaultMs) + "]: ");
+            int budgetMs = defaultMs;
+            try {
+                budgetMs = std::max(0, std::stoi(input));
+            } catch (const std::exception &) {
+                budgetMs = defaultMs;
+            }
+            options.budget = std::chrono::milliseconds(budgetMs);
+        }
 
         // run and time
         auto start = std::chrono::steady_clock::now();
-        std::vector<Pallet> result;
-        switch (algo) {
-            case 1: result = exhaustiveSearch(pallets, capacity); break;
-            case 2: result = backtracking(pallets, capacity);   break;
-            case 3: result = dynamicProgramming(pallets, capacity); break;
-            case 4: result = approximationAlgorithm(pallets, capacity); break;
-            case 5: result = integerLinearProgramming(pallets, capacity); break;
-        }
+        Instance instance(pallets, capacity);
+        SolveResult solved = solver.solve(instance, options);
         auto end = std::chrono::steady_clock::now();
         double elapsed = std::chrono::duration<double>(end - start).count();
+        std::vector<Pallet> result = solved.solution.toPallets(pallets);
+        long long upperBound = solved.upperBound;
 
         // display results in table
-        std::cout << "\n" << (algo == 4 ? "Approximate" : "Optimal")
+        std::cout << "\n" << (solved.optimal ? "Optimal" : "Approximate")
                   << " solution:\n";
         std::cout << std::left
                   << std::setw(12) << "Pallet ID"
@@ -142,10 +566,9 @@ int main() {
                   << std::setw(12) << "Profit" << "\n";
         std::cout << std::string(36, '-') << "\n";
 
-        int count = 0, totalW = 0, totalP = 0;
+        int totalW = 0, totalP = 0;
         for (size_t i = 0; i < result.size(); ++i) {
             if (result[i].weight > 0) {
-                ++count;
                 totalW += result[i].weight;
                 totalP += result[i].profit;
                 std::cout << std::left
@@ -159,6 +582,11 @@ int main() {
                   << std::setw(12) << "Total"
                   << std::setw(12) << totalW
                   << std::setw(12) << totalP << "\n";
+        if (upperBound >= 0) {
+            double gap = upperBound > 0 ? 100.0 * (upperBound - totalP) / upperBound : 0.0;
+            std::cout << "Proven upper bound: " << upperBound
+                      << " (at most " << std::fixed << std::setprecision(2) << gap << "% below optimal)\n";
+        }
         std::cout << std::fixed << std::setprecision(6)
                   << "Elapsed time: " << elapsed << "s\n";
 
@@ -0,0 +1,70 @@
+/**
+ * @file mappedfile.h
+ * @brief Read-only memory mapping of a whole file.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file, memory-mapped when possible.
+ *
+ * Falls back to reading the file into memory when it cannot be mapped
+ * (pipes, special files).
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            length = st.st_size;
+            opened = true;
+            if (length > 0) {
+                void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    ::madvise(mapped, length, MADV_SEQUENTIAL);
+                    data = static_cast<const char*>(mapped);
+                }
+            }
+        }
+        ::close(fd);
+
+        if (!data && (!opened || length > 0)) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) return;
+            fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            opened = true;
+            length = fallback.size();
+        }
+    }
+
+    ~MappedFile() {
+        if (data) ::munmap(const_cast<char*>(data), length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return opened; }
+    const char* begin() const { return data ? data : fallback.data(); }
+    const char* end() const { return begin() + length; }
+
+private:
+    const char* data = nullptr;   ///< Mapping, or nullptr when the fallback holds the bytes
+    size_t length = 0;
+    std::string fallback;
+    bool opened = false;
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,435 @@
+/**
+ * @file multidim.cpp
+ * @brief Surrogate-bound branch and bound and greedy for the multi-dimensional knapsack.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "multidim.h"
+
+// ====================================================================== //
+// =========================== RESOURCE MODEL =========================== //
+// ====================================================================== //
+
+/**
+ * @struct ResourceModel
+ * @brief The binding dimensions of an instance: limits and use of every pallet.
+ *
+ * Dimensions whose limit is unset or that all pallets together respect
+ * are dropped, so d is often much smaller than the five candidates.
+ */
+struct ResourceModel {
+    int dims = 0;
+    std::vector<int> kind;          ///< Candidate dimension of each binding one (0 = weight)
+    std::vector<long long> limit;   ///< Limit per binding dimension
+    std::vector<long long> use;     ///< use[i * dims + d]: use of pallet i in dimension d
+    std::vector<int> usable;        ///< Pallets with a profit that fit the empty truck
+};
+
+/**
+ * @brief Use of a pallet in one of the candidate dimensions.
+ *
+ * Candidates are weight, volume, slots, front axle and rear axle.
+ */
+long long candidateUse(const Pallet& pallet, int kind) {
+    switch (kind) {
+        case 0: return pallet.weight;
+        case 1: return pallet.volume;
+        case 2: return pallet.slots;
+        case 3: return pallet.frontAxle;
+        default: return std::max(0, pallet.weight - pallet.frontAxle);
+    }
+}
+
+/**
+ * @brief Collects the usable pallets and the dimensions that bind on them.
+ *
+ * @complexity Time: O(n)
+ */
+ResourceModel buildResourceModel(const std::vector<Pallet>& pallets, const Truck& truck) {
+    const int candidates = 5;
+    const long long limits[candidates] = {truck.capacity, truck.volume, truck.slots, truck.frontAxle, truck.rearAxle};
+    int n = pallets.size();
+
+    ResourceModel model;
+    long long totals[candidates] = {0, 0, 0, 0, 0};
+    for (int i = 0; i < n; i++) {
+        if (pallets[i].profit <= 0) continue;
+        // A pallet over a limit on its own makes that limit bind as well
+        for (int c = 0; c < candidates; c++) totals[c] += candidateUse(pallets[i], c);
+        bool fits = true;
+        for (int c = 0; c < candidates; c++) {
+            if (limits[c] >= 0 && candidateUse(pallets[i], c) > limits[c]) fits = false;
+        }
+        if (!fits) continue;
+        model.usable.push_back(i);
+    }
+
+    for (int c = 0; c < candidates; c++) {
+        if (limits[c] < 0 || totals[c] <= limits[c]) continue;
+        model.kind.push_back(c);
+        model.limit.push_back(limits[c]);
+    }
+    model.dims = model.kind.size();
+
+    model.use.assign((size_t)n * model.dims, 0);
+    for (int i : model.usable) {
+        for (int d = 0; d < model.dims; d++) model.use[(size_t)i * model.dims + d] = candidateUse(pallets[i], model.kind[d]);
+    }
+    return model;
+}
+
+bool hasBindingExtraLimits(const std::vector<Pallet>& pallets, const Truck& truck) {
+    ResourceModel model = buildResourceModel(pallets, truck);
+    for (int kind : model.kind) {
+        if (kind != 0) return true;
+    }
+    return false;
+}
+
+// ====================================================================== //
+// ======================== SURROGATE RELAXATION ======================== //
+// ====================================================================== //
+
+/**
+ * @struct Surrogate
+ * @brief One-constraint relaxation: every dimension weighted by a multiplier.
+ */
+struct Surrogate {
+    std::vector<double> multiplier;  ///< Multiplier per dimension
+    std::vector<double> size;        ///< Surrogate size of every pallet
+    std::vector<int> order;          ///< Usable pallets by decreasing profit per surrogate size
+    double capacity = 0;             ///< Surrogate capacity of the empty truck
+};
+
+/**
+ * @brief Builds the surrogate sizes and ratio order for the given multipliers.
+ *
+ * @complexity Time: O(n * d + n log n)
+ */
+Surrogate makeSurrogate(const std::vector<Pallet>& pallets, const ResourceModel& model,
+                        const std::vector<double>& multiplier) {
+    Surrogate s;
+    s.multiplier = multiplier;
+    s.size.assign(pallets.size(), 0);
+    for (int d = 0; d < model.dims; d++) s.capacity += multiplier[d] * model.limit[d];
+    for (int i : model.usable) {
+        for (int d = 0; d < model.dims; d++) s.size[i] += multiplier[d] * model.use[(size_t)i * model.dims + d];
+    }
+
+    s.order = model.usable;
+    std::stable_sort(s.order.begin(), s.order.end(), [&](int a, int b) {
+        // p_a / s_a > p_b / s_b, free pallets first
+        return pallets[a].profit * s.size[b] > pallets[b].profit * s.size[a];
+    });
+    return s;
+}
+
+/**
+ * @brief LP bound of the surrogate knapsack over all usable pallets.
+ *
+ * @complexity Time: O(n)
+ */
+double surrogateRootBound(const std::vector<Pallet>& pallets, const Surrogate& s) {
+    double room = s.capacity, bound = 0;
+    for (int i : s.order) {
+        if (s.size[i] <= room) {
+            room -= s.size[i];
+            bound += pallets[i].profit;
+        } else {
+            bound += pallets[i].profit * room / s.size[i];
+            break;
+        }
+    }
+    return bound;
+}
+
+/**
+ * @brief Picks surrogate multipliers with a small LP bound.
+ *
+ * Starts from the best of the normalised limits, each single dimension and
+ * the limits weighted by their overload, then scales one multiplier at a
+ * time by a shrinking factor while the bound decreases.
+ *
+ * @complexity Time: O(iterations * d * (n * d + n log n))
+ */
+Surrogate chooseSurrogate(const std::vector<Pallet>& pallets, const ResourceModel& model) {
+    int dims = model.dims;
+    std::vector<std::vector<double>> starts;
+    std::vector<double> uniform(dims), overload(dims, 0);
+    for (int d = 0; d < dims; d++) uniform[d] = 1.0 / std::max(1LL, model.limit[d]);
+    starts.push_back(uniform);
+    for (int d = 0; d < dims; d++) {
+        std::vector<double> single(dims, 0);
+        single[d] = uniform[d];
+        starts.push_back(single);
+    }
+    for (int i : model.usable) {
+        for (int d = 0; d < dims; d++) overload[d] += model.use[(size_t)i * dims + d] * uniform[d];
+    }
+    for (int d = 0; d < dims; d++) overload[d] *= uniform[d];
+    starts.push_back(overload);
+
+    Surrogate best = makeSurrogate(pallets, model, starts[0]);
+    double bestBound = surrogateRootBound(pallets, best);
+    for (size_t k = 1; k < starts.size(); k++) {
+        Surrogate s = makeSurrogate(pallets, model, starts[k]);
+        double bound = surrogateRootBound(pallets, s);
+        if (bound < bestBound) {
+            best = s;
+            bestBound = bound;
+        }
+    }
+
+    double factor = 2.0;
+    for (int round = 0; dims > 1 && factor > 1.01 && round < 64; round++) {
+        bool improved = false;
+        for (int d = 0; d < dims; d++) {
+            for (double scale : {factor, 1.0 / factor}) {
+                std::vector<double> multiplier = best.multiplier;
+                multiplier[d] = (multiplier[d] > 0 ? multiplier[d] : uniform[d] / 16) * scale;
+                Surrogate s = makeSurrogate(pallets, model, multiplier);
+                double bound = surrogateRootBound(pallets, s);
+                if (bound < bestBound - 1e-9) {
+                    best = s;
+                    bestBound = bound;
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) factor = std::sqrt(factor);
+    }
+    return best;
+}
+
+// ====================================================================== //
+// ====================== MULTI-DIMENSIONAL SEARCH ====================== //
+// ====================================================================== //
+
+/**
+ * @brief Checks that a pallet fits the residual limits.
+ */
+bool fitsResidual(const ResourceModel& model, const std::vector<long long>& residual, int pallet) {
+    const long long* use = &model.use[(size_t)pallet * model.dims];
+    for (int d = 0; d < model.dims; d++) {
+        if (use[d] > residual[d]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Adds (sign = -1) or removes (sign = 1) a pallet's use from the residual limits.
+ */
+void updateResidual(const ResourceModel& model, std::vector<long long>& residual, int pallet, int sign) {
+    const long long* use = &model.use[(size_t)pallet * model.dims];
+    for (int d = 0; d < model.dims; d++) residual[d] += sign * use[d];
+}
+
+/**
+ * @brief Greedy load in surrogate order, then 1-swap improvement.
+ *
+ * @return Whether each pallet is loaded
+ */
+std::vector<char> greedyLoad(const std::vector<Pallet>& pallets, const ResourceModel& model, const Surrogate& s) {
+    std::vector<char> taken(pallets.size(), 0);
+    std::vector<long long> residual = model.limit;
+    for (int i : s.order) {
+        if (fitsResidual(model, residual, i)) {
+            updateResidual(model, residual, i, -1);
+            taken[i] = 1;
+        }
+    }
+
+    // Replace a loaded pallet by a more profitable one left behind
+    for (bool improved = true; improved;) {
+        improved = false;
+        for (int out : s.order) {
+            if (taken[out]) continue;
+            for (int in : s.order) {
+                if (!taken[in] || pallets[in].profit >= pallets[out].profit) continue;
+                updateResidual(model, residual, in, 1);
+                if (fitsResidual(model, residual, out)) {
+                    updateResidual(model, residual, out, -1);
+                    taken[in] = 0;
+                    taken[out] = 1;
+                    improved = true;
+                    break;
+                }
+                updateResidual(model, residual, in, -1);
+            }
+        }
+        for (int i : s.order) {
+            if (!taken[i] && fitsResidual(model, residual, i)) {
+                updateResidual(model, residual, i, -1);
+                taken[i] = 1;
+                improved = true;
+            }
+        }
+    }
+    return taken;
+}
+
+/**
+ * @brief Converts a loaded flag per pallet into the result load.
+ */
+Solution selectedPallets(const std::vector<Pallet>& pallets, const std::vector<char>& taken) {
+    Solution result(pallets.size());
+    for (size_t i = 0; i < pallets.size(); i++) {
+        if (taken[i]) result.take(i, pallets[i].weight, pallets[i].profit);
+    }
+    return result;
+}
+
+Solution multiDimensionalGreedy(const std::vector<Pallet>& pallets, const Truck& truck) {
+    ResourceModel model = buildResourceModel(pallets, truck);
+    Surrogate s = chooseSurrogate(pallets, model);
+    return selectedPallets(pallets, greedyLoad(pallets, model, s));
+}
+
+/**
+ * @struct MultiBranchContext
+ * @brief Shared state of a multi-dimensional branch-and-bound run.
+ */
+struct MultiBranchContext {
+    const std::vector<Pallet>& pallets;
+    const ResourceModel& model;
+    const Surrogate& surrogate;
+    std::vector<long long> residual;
+    std::vector<char> taken;
+    std::vector<char> best;
+    long long bestProfit = 0;
+    long long bestWeight = 0;
+    const CancellationToken* token = nullptr;
+    long long steps = 0;     ///< Nodes visited, paces the token polls
+    bool stopped = false;    ///< Sticky once the token asked to stop
+};
+
+/**
+ * @brief Fractional surrogate bound over order[level..) for the residual limits.
+ *
+ * Pallets that no longer fit on their own are skipped, which keeps the
+ * bound valid and tighter than the plain surrogate LP.
+ *
+ * @complexity Time: O((n - level) * d)
+ */
+double multiBound(const MultiBranchContext& ctx, int level) {
+    const Surrogate& s = ctx.surrogate;
+    double room = 0, bound = 0;
+    for (int d = 0; d < ctx.model.dims; d++) room += s.multiplier[d] * ctx.residual[d];
+    for (size_t k = level; k < s.order.size(); k++) {
+        int i = s.order[k];
+        if (!fitsResidual(ctx.model, ctx.residual, i)) continue;
+        if (s.size[i] <= room) {
+            room -= s.size[i];
+            bound += ctx.pallets[i].profit;
+        } else {
+            bound += ctx.pallets[i].profit * room / s.size[i];
+            break;
+        }
+    }
+    return bound;
+}
+
+/**
+ * @brief Depth-first search from the root, taking the pallet before leaving it.
+ *
+ * The search is iterative. Each inclusion leaves its exclusion sibling on
+ * an explicit stack, and the levels of the taken pallets are stacked too,
+ * so resuming at a sibling gives back the residual of every pallet taken
+ * at or below it.
+ *
+ * @complexity Time: O(2^n * n * d) - Worst case, bounds prune most of it
+ * @complexity Space: O(n) - Both stacks
+ */
+void multiBranch(MultiBranchContext& ctx) {
+    struct Sibling {
+        long long profit;
+        long long weight;
+        int level;  ///< The sibling leaves out the pallet at level - 1
+    };
+
+    const std::vector<int>& order = ctx.surrogate.order;
+    int n = order.size();
+    std::vector<Sibling> siblings;
+    std::vector<int> takenLevels;
+    siblings.reserve(n);
+    takenLevels.reserve(n);
+
+    int level = 0;
+    long long profit = 0, weight = 0;
+    while (true) {
+        if ((++ctx.steps & 1023) == 0 && stopRequested(ctx.token)) {
+            ctx.stopped = true;
+            return;
+        }
+
+        if (profit > ctx.bestProfit || (profit == ctx.bestProfit && weight < ctx.bestWeight)) {
+            ctx.best = ctx.taken;
+            ctx.bestProfit = profit;
+            ctx.bestWeight = weight;
+        }
+
+        // Weight only grows below this node, so a tie needs a lighter load than the incumbent
+        bool expand = level < n;
+        if (expand) {
+            long long bound = profit + (long long)std::floor(multiBound(ctx, level) + 1e-9);
+            expand = bound > ctx.bestProfit || (bound == ctx.bestProfit && weight < ctx.bestWeight);
+        }
+        if (!expand) {
+            if (siblings.empty()) return;
+            Sibling next = siblings.back();
+            siblings.pop_back();
+            level = next.level;
+            profit = next.profit;
+            weight = next.weight;
+            while (!takenLevels.empty() && takenLevels.back() >= level - 1) {
+                int item = order[takenLevels.back()];
+                ctx.taken[item] = 0;
+                updateResidual(ctx.model, ctx.residual, item, 1);
+                takenLevels.pop_back();
+            }
+            continue;
+        }
+
+        int item = order[level];
+        if (fitsResidual(ctx.model, ctx.residual, item)) {
+            siblings.push_back({profit, weight, level + 1});
+            updateResidual(ctx.model, ctx.residual, item, -1);
+            ctx.taken[item] = 1;
+            takenLevels.push_back(level);
+            profit += ctx.pallets[item].profit;
+            weight += ctx.pallets[item].weight;
+        }
+        level++;
+    }
+}
+
+Solution multiDimensionalBranchAndBound(const std::vector<Pallet>& pallets, const Truck& truck,
+                                                   const CancellationToken* token) {
+    ResourceModel model = buildResourceModel(pallets, truck);
+    Surrogate s = chooseSurrogate(pallets, model);
+
+    MultiBranchContext ctx{pallets, model, s, model.limit, std::vector<char>(pallets.size(), 0), {}};
+    ctx.token = token;
+    ctx.best = greedyLoad(pallets, model, s);
+    for (size_t i = 0; i < pallets.size(); i++) {
+        if (!ctx.best[i]) continue;
+        ctx.bestProfit += pallets[i].profit;
+        ctx.bestWeight += pallets[i].weight;
+    }
+
+    multiBranch(ctx);
+    return selectedPallets(pallets, ctx.best);
+}
+
+SolveResult multiDimensionalSolve(const std::vector<Pallet>& pallets, const Truck& truck, const SolveOptions& options,
+                                  bool exact) {
+    // Only the weight binds: the 1-D engines solve it as they are
+    if (!hasBindingExtraLimits(pallets, truck)) {
+        Instance instance(pallets, truck.capacity);
+        return findSolver("auto")->solve(instance, options);
+    }
+
+    if (exact) return makeResult(multiDimensionalBranchAndBound(pallets, truck, options.token), true, options, "md-bnb");
+    return makeResult(multiDimensionalGreedy(pallets, truck), false, options, "md-greedy");
+}
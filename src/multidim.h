@@ -0,0 +1,84 @@
+/**
+ * @file multidim.h
+ * @brief Multi-dimensional knapsack: weight, volume, floor slots and axle loads.
+ */
+
+#ifndef MULTIDIM_H
+#define MULTIDIM_H
+
+#include <vector>
+#include "cancellation.h"
+#include "pallet.h"
+#include "solver.h"
+#include "truck.h"
+
+/**
+ * @brief Checks whether any limit other than the weight can bind.
+ *
+ * A limit binds when it is set and the pallets together exceed it. The
+ * rear axle carries the part of each pallet's weight not on the front axle.
+ *
+ * @param pallets Vector of pallet objects
+ * @param truck Truck and its limits
+ * @return True if volume, slots or an axle limit is exceeded by all pallets together
+ *
+ * @complexity Time: O(n)
+ */
+bool hasBindingExtraLimits(const std::vector<Pallet>& pallets, const Truck& truck);
+
+/**
+ * @brief Greedy multi-dimensional load followed by a 1-swap improvement.
+ *
+ * Pallets are taken by decreasing profit per unit of surrogate resource
+ * (see multiDimensionalBranchAndBound()) while they fit every limit; then
+ * a pallet left behind replaces a loaded one whenever that is feasible and
+ * gains profit.
+ *
+ * @param pallets Vector of pallet objects
+ * @param truck Truck and its limits
+ * @return Selected pallets
+ *
+ * @complexity Time: O(n^2 * d) - d binding dimensions
+ * @complexity Space: O(n * d)
+ */
+Solution multiDimensionalGreedy(const std::vector<Pallet>& pallets, const Truck& truck);
+
+/**
+ * @brief Exact multi-dimensional knapsack by branch and bound on surrogate bounds.
+ *
+ * The binding limits are combined into one surrogate constraint with
+ * multipliers chosen at the root to minimise its LP bound (starting from
+ * the normalised limits and refined by coordinate search). Depth-first
+ * search in surrogate ratio order bounds each node by the fractional
+ * surrogate knapsack over the pallets that still fit individually. The
+ * greedy seeds the incumbent; ties keep the lighter load as the 1-D
+ * solvers do.
+ *
+ * @param pallets Vector of pallet objects
+ * @param truck Truck and its limits
+ * @param token Stops the search early; the best load found is returned
+ * @return Selected pallets
+ *
+ * @complexity Time: O(2^n * n * d) - Worst case, bounds prune most of it
+ * @complexity Space: O(n * d)
+ */
+Solution multiDimensionalBranchAndBound(const std::vector<Pallet>& pallets, const Truck& truck,
+                                        const CancellationToken* token = nullptr);
+
+/**
+ * @brief Solves a load under every limit of the truck.
+ *
+ * When only the weight can bind, the problem is the plain 0/1 knapsack and
+ * goes to the auto strategy, so the 1-D engines keep their speed. Otherwise
+ * the multi-dimensional branch and bound (exact) or greedy runs.
+ *
+ * @param pallets Vector of pallet objects
+ * @param truck Truck and its limits
+ * @param options Options passed to the engine
+ * @param exact Use the branch and bound rather than the greedy
+ * @return Load with the engine used ("md-bnb", "md-greedy" or the 1-D pick)
+ */
+SolveResult multiDimensionalSolve(const std::vector<Pallet>& pallets, const Truck& truck, const SolveOptions& options,
+                                  bool exact = true);
+
+#endif // MULTIDIM_H
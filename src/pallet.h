@@ -13,10 +13,17 @@
  * This structure is used in the 0/1 knapsack problem context to represent
  * a pallet that can be loaded onto a truck. Each pallet has a specific weight
  * and generates a certain profit.
+ *
+ * Volume, floor slots and the front axle share are only read by the
+ * multi-dimensional solver; they default to 0 so {weight, profit} pallets
+ * (and the {0, 0} of a pallet left behind) keep their meaning.
  */
 struct Pallet {
-    int weight;  ///< The weight of the pallet
-    int profit;  ///< The profit obtained from the pallet
+    int weight;          ///< The weight of the pallet
+    int profit;          ///< The profit obtained from the pallet
+    int volume = 0;      ///< Volume taken in the cargo space
+    int slots = 0;       ///< Floor positions taken
+    int frontAxle = 0;   ///< Part of the weight carried by the front axle, the rest goes to the rear
 };
 
 #endif // PALLET_H
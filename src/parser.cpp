@@ -1,53 +1,228 @@
 /**
  * @file parser.cpp
  * @brief Functions to parse CSV input files containing pallet and truck information.
+ *
+ * Files are memory-mapped and scanned in place: lines and fields are
+ * pointer ranges into the mapping and integers are read with
+ * std::from_chars, so no string is built per row.
  */
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include "mappedfile.h"
 #include "parser.h"
 
+namespace {
+
+/**
+ * @class LineScanner
+ * @brief Walks the lines of a buffer, stripping the '\r' of CRLF endings.
+ */
+class LineScanner {
+public:
+    LineScanner(const char* begin, const char* end) : cursor(begin), last(end) {}
+
+    /**
+     * @brief Moves to the next line.
+     * @return False at the end of the buffer
+     */
+    bool next(std::string_view& line) {
+        if (cursor >= last) return false;
+        const char* eol = static_cast<const char*>(std::memchr(cursor, '\n', last - cursor));
+        if (!eol) eol = last;
+        const char* stop = (eol > cursor && eol[-1] == '\r') ? eol - 1 : eol;
+        line = std::string_view(cursor, stop - cursor);
+        cursor = eol + 1;
+        number++;
+        return true;
+    }
+
+    size_t lineNumber() const { return number; }
+
+    /// Upper bound on the lines left, used to reserve the output
+    size_t remainingLines() const {
+        size_t count = 1;
+        for (const char* p = cursor; p < last; count++) {
+            p = static_cast<const char*>(std::memchr(p, '\n', last - p));
+            if (!p) break;
+            p++;
+        }
+        return count;
+    }
+
+private:
+    const char* cursor;
+    const char* last;
+    size_t number = 0;
+};
+
+/**
+ * @brief Trims spaces and tabs from both ends of a field.
+ */
+std::string_view trimField(std::string_view field) {
+    const char* first = field.data();
+    const char* last = first + field.size();
+    while (first < last && (*first == ' ' || *first == '\t')) first++;
+    while (last > first && (last[-1] == ' ' || last[-1] == '\t')) last--;
+    return std::string_view(first, last - first);
+}
+
+/**
+ * @brief Reads a whole field as an int.
+ * @return False if the field is empty, not a number, out of range or has trailing characters
+ */
+bool parseIntField(std::string_view field, int& value) {
+    field = trimField(field);
+    if (field.empty()) return false;
+    const char* first = field.data();
+    if (*first == '+') first++;
+    auto [ptr, ec] = std::from_chars(first, field.data() + field.size(), value);
+    return ec == std::errc() && ptr == field.data() + field.size();
+}
+
+/**
+ * @brief Finds the position of each named column in a CSV header line.
+ *
+ * @param header The header line.
+ * @param names Column names to look for.
+ * @param columns Receives the position of each name; entries of missing names are left unchanged.
+ */
+void locateColumns(std::string_view header, const std::vector<std::string_view>& names, std::vector<int>& columns) {
+    int column = 0;
+    for (size_t start = 0; start <= header.size(); column++) {
+        size_t comma = header.find(',', start);
+        if (comma == std::string_view::npos) comma = header.size();
+        std::string_view name = trimField(header.substr(start, comma - start));
+        for (size_t i = 0; i < names.size(); i++) {
+            if (name == names[i]) columns[i] = column;
+        }
+        start = comma + 1;
+    }
+}
+
+/**
+ * @struct ColumnMap
+ * @brief Inverse of the located columns: which value, if any, each field fills.
+ */
+struct ColumnMap {
+    std::vector<int> columns;   ///< Position of each value, -1 if absent
+    std::vector<int> slot;      ///< slot[column]: index of the value it fills, or -1
+    unsigned required;          ///< Bit mask of the values that must be present
+
+    ColumnMap(const std::vector<int>& positions, size_t requiredCount) : columns(positions), required(0) {
+        int last = *std::max_element(positions.begin(), positions.end());
+        slot.assign(last + 1, -1);
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (positions[i] >= 0) slot[positions[i]] = i;
+        }
+        for (size_t i = 0; i < requiredCount; i++) required |= 1u << i;
+    }
+};
+
+/**
+ * @brief Reads the mapped integer columns of a data line.
+ *
+ * Fields after the last mapped column are not looked at, and empty fields
+ * count as absent.
+ *
+ * @param line The line, without its end of line
+ * @param map Columns to read
+ * @param values Receives the values, in the order of map.columns
+ * @param error Receives a description of the first problem
+ * @return False if a mapped field is not an integer or a required one is missing
+ */
+bool readColumns(std::string_view line, const ColumnMap& map, int* values, std::string& error) {
+    const char* field = line.data();
+    const char* end = field + line.size();
+    unsigned seen = 0;
+
+    for (int column = 0; column < (int)map.slot.size(); column++) {
+        const char* comma = static_cast<const char*>(std::memchr(field, ',', end - field));
+        if (!comma) comma = end;
+        int i = map.slot[column];
+        std::string_view text(field, comma - field);
+        // An empty field leaves the value at its default
+        if (i >= 0 && !trimField(text).empty()) {
+            if (!parseIntField(text, values[i])) {
+                error = "expected an integer in column " + std::to_string(column + 1) + ", got '" +
+                        std::string(trimField(text)) + "'";
+                return false;
+            }
+            seen |= 1u << i;
+        }
+        if (comma == end) break;
+        field = comma + 1;
+    }
+    if ((seen & map.required) != map.required) {
+        for (size_t i = 0; i < map.columns.size(); i++) {
+            if ((map.required >> i & 1) && !(seen >> i & 1)) {
+                error = "missing column " + std::to_string(map.columns[i] + 1);
+                break;
+            }
+        }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Builds the message of a malformed row.
+ */
+std::runtime_error rowError(const std::string& filePath, size_t lineNumber, const std::string& what) {
+    return std::runtime_error(filePath + ":" + std::to_string(lineNumber) + ": " + what);
+}
+
+} // namespace
+
 /**
  * @brief Parses the pallets data from a CSV file.
  *
  * Each line in the CSV file is expected to have the format:
  * PalletID,Weight,Profit
  *
+ * Optional Volume, Slots and FrontAxle columns, found by their header
+ * names, fill the extra dimensions of the pallets. Blank lines are skipped.
+ *
  * @param filePath The path to the CSV file containing pallet data.
  * @return A vector of Pallet objects parsed from the file.
+ * @throws std::runtime_error naming the file and line of a malformed row.
+ *
+ * @complexity Time: O(file size)
  */
 std::vector<Pallet> parsePalletsCSV(std::string filePath) {
-    std::ifstream file(filePath);
-    if (!file) {
+    MappedFile file(filePath);
+    if (!file.ok()) {
         std::cerr << "Error opening file.\n";
         return {};
     }
 
     std::vector<Pallet> pallets;
-    std::string line;
+    LineScanner lines(file.begin(), file.end());
+    std::string_view line;
 
-    // Skip header
-    if (!std::getline(file, line)) {
+    // Header gives the column positions, Weight and Profit default to the second and third
+    if (!lines.next(line)) {
         return pallets;
     }
+    std::vector<int> columns = {1, 2, -1, -1, -1};
+    locateColumns(line, {"Weight", "Profit", "Volume", "Slots", "FrontAxle"}, columns);
+    ColumnMap map(columns, 2);
 
-    while (std::getline(file, line)) {
-        std::istringstream ss(line);
-        std::string token;
-        Pallet p;
-
-        // Skip Pallet ID
-        if (!std::getline(ss, token, ',')) continue;
-
-        // Weight
-        if (!std::getline(ss, token, ',')) continue;
-        p.weight = std::stoi(token);
-
-        // Profit
-        if (!std::getline(ss, token, ',')) continue;
-        p.profit = std::stoi(token);
+    pallets.reserve(lines.remainingLines());
+    std::string error;
+    while (lines.next(line)) {
+        if (line.empty() || trimField(line).empty()) continue;
+        int values[5] = {0, 0, 0, 0, 0};
+        if (!readColumns(line, map, values, error)) throw rowError(filePath, lines.lineNumber(), error);
 
+        Pallet p{values[0], values[1]};
+        p.volume = values[2];
+        p.slots = values[3];
+        p.frontAxle = values[4];
         pallets.push_back(p);
     }
 
@@ -66,24 +241,79 @@ std::vector<Pallet> parsePalletsCSV(std::string filePath) {
  * @return The truck's maximum weight capacity. Returns -1 if the file cannot be read.
  */
 int parseTruckAndPalletsCSV(std::string filePath) {
-    std::ifstream file(filePath);
-    if (!file) {
+    MappedFile file(filePath);
+    if (!file.ok()) {
         std::cerr << "Error opening file.\n";
         return -1;
     }
 
-    std::string line;
+    LineScanner lines(file.begin(), file.end());
+    std::string_view line;
 
-    // Skip header
-    if (!std::getline(file, line)) {
+    // Skip header, then read the first value of the data line
+    int capacity = -1;
+    if (!lines.next(line) || !lines.next(line)) {
+        return -1;
+    }
+    if (!parseIntField(line.substr(0, line.find(',')), capacity)) {
         return -1;
     }
-
-    // Read actual data line
-    std::getline(file, line);
-    std::istringstream ss(line);
-    
-    int capacity = -1;
-    ss >> capacity;
     return capacity;
 }
+
+/**
+ * @brief Parses a fleet of trucks from a CSV file.
+ *
+ * The header locates the Capacity and (optional) Truck columns, so both
+ * "Capacity,Pallets" and "Truck,Capacity" files are accepted.
+ *
+ * @param filePath The path to the CSV file containing the trucks.
+ * @return The trucks in file order. Returns an empty vector if the file cannot be read.
+ * @throws std::runtime_error naming the file and line of a malformed row.
+ */
+std::vector<Truck> parseTrucksCSV(std::string filePath) {
+    MappedFile file(filePath);
+    if (!file.ok()) {
+        std::cerr << "Error opening file.\n";
+        return {};
+    }
+
+    std::vector<Truck> trucks;
+    LineScanner lines(file.begin(), file.end());
+    std::string_view line;
+
+    // Header gives the column positions
+    if (!lines.next(line)) {
+        return trucks;
+    }
+    std::vector<int> columns = {0, -1, -1, -1, -1, -1};
+    locateColumns(line, {"Capacity", "Truck", "Volume", "Slots", "FrontAxle", "RearAxle"}, columns);
+    ColumnMap map(columns, 1);
+
+    std::string error;
+    while (lines.next(line)) {
+        if (trimField(line).empty()) continue;
+        int values[6] = {-1, (int)trucks.size() + 1, -1, -1, -1, -1};
+        if (!readColumns(line, map, values, error)) throw rowError(filePath, lines.lineNumber(), error);
+        if (values[0] < 0) continue;
+
+        Truck truck{values[1], values[0]};
+        truck.volume = values[2];
+        truck.slots = values[3];
+        truck.frontAxle = values[4];
+        truck.rearAxle = values[5];
+        trucks.push_back(truck);
+    }
+
+    return trucks;
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) return text;
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
@@ -9,15 +9,19 @@
 #include <string>
 #include <vector>
 #include "pallet.h"
+#include "truck.h"
 
 /**
  * @brief Parses a CSV file containing pallet information.
  *
  * Expects a file where each line has the format: PalletID,Weight,Profit
  * Skips the header line and converts each line into a Pallet object.
+ * Volume, Slots and FrontAxle columns are read when the header names them.
+ * The file is memory-mapped and scanned with std::from_chars.
  *
  * @param filePath The path to the CSV file.
  * @return A vector of Pallet objects parsed from the file.
+ * @throws std::runtime_error "path:line: reason" for a malformed row.
  */
 std::vector<Pallet> parsePalletsCSV(std::string filePath);
 
@@ -32,4 +36,29 @@ std::vector<Pallet> parsePalletsCSV(std::string filePath);
  */
 int parseTruckAndPalletsCSV(std::string filePath);
 
+/**
+ * @brief Parses every truck listed in a CSV file.
+ *
+ * Each line after the header describes one truck. The header names the
+ * columns: "Capacity" is required, "Truck" optionally gives an ID, and
+ * "Volume", "Slots", "FrontAxle" and "RearAxle" optionally set the other
+ * limits; other columns are ignored. A TruckAndPallets file
+ * (Capacity,Pallets) is thus read as a fleet of one truck.
+ *
+ * @param filePath The path to the CSV file.
+ * @return The trucks in file order (empty if the file cannot be read).
+ * @throws std::runtime_error "path:line: reason" for a malformed row.
+ */
+std::vector<Truck> parseTrucksCSV(std::string filePath);
+
+/**
+ * @brief Quotes a CSV field if it holds a comma, a quote or a line break.
+ *
+ * Quotes inside the field are doubled, as RFC 4180 reads them.
+ *
+ * @param text The raw field.
+ * @return The field, ready to be written between separators.
+ */
+std::string csvField(const std::string& text);
+
 #endif // PARSER_H
@@ -0,0 +1,192 @@
+/**
+ * @file session.cpp
+ * @brief Incremental DP rows and warm-started branch and bound of PackingSession.
+ */
+
+#include <algorithm>
+#include "algorithms.h"
+#include "session.h"
+
+PackingSession::PackingSession(int capacity) : truckCapacity(std::max(0, capacity)) {}
+
+int PackingSession::addPallet(const Pallet& pallet) {
+    items.push_back(pallet);
+    handles.push_back(nextHandle);
+    loaded.push_back(0);
+    planValid = false;
+    return nextHandle++;
+}
+
+bool PackingSession::removePallet(int id) {
+    auto it = std::find(handles.begin(), handles.end(), id);
+    if (it == handles.end()) return false;
+    size_t k = it - handles.begin();
+
+    // The old load is still feasible, and still optimal if the pallet was not in it
+    if (loaded[k]) planValid = false;
+
+    items.erase(items.begin() + k);
+    handles.erase(handles.begin() + k);
+    loaded.erase(loaded.begin() + k);
+
+    // rows[0..k] do not involve the pallet; the spare row is kept for reuse
+    if (k + 1 < rows.size()) std::rotate(rows.begin() + k + 1, rows.begin() + k + 2, rows.end());
+    validRows = std::min(validRows, k + 1);
+    return true;
+}
+
+void PackingSession::setCapacity(int capacity) {
+    capacity = std::max(0, capacity);
+    if (capacity > truckCapacity) {
+        planValid = false;
+    } else if (planValid) {
+        // Shrinking keeps an optimal load optimal as long as it still fits
+        long long weight = 0;
+        for (size_t i = 0; i < items.size(); i++) {
+            if (loaded[i]) weight += items[i].weight;
+        }
+        if (weight > capacity) planValid = false;
+    }
+    truckCapacity = capacity;
+}
+
+bool PackingSession::tableFits() const {
+    return (long long)(items.size() + 1) * (truckCapacity + 1) <= tableCellLimit;
+}
+
+/**
+ * @brief Recomputes the stale rows and widens the valid ones to the capacity.
+ *
+ * @complexity Time: O(stale rows * C + valid rows * dC)
+ */
+void PackingSession::rebuildRows() {
+    size_t n = items.size();
+    if (validRows == 0 || (long long)(n + 1) * (rowCapacity + 1) > tableCellLimit) {
+        // Start over at the current capacity
+        validRows = 0;
+        rowCapacity = truckCapacity;
+    }
+
+    // Widen the valid rows: cells above the old width depend only on the rows above
+    if (rowCapacity < truckCapacity) {
+        for (size_t i = 0; i < validRows; i++) {
+            std::vector<int>& row = rows[i];
+            row.resize(truckCapacity + 1);
+            for (int c = rowCapacity + 1; c <= truckCapacity; c++) {
+                if (i == 0) {
+                    row[c] = 0;
+                    continue;
+                }
+                const Pallet& pallet = items[i - 1];
+                row[c] = rows[i - 1][c];
+                if (c >= pallet.weight) row[c] = std::max(row[c], rows[i - 1][c - pallet.weight] + pallet.profit);
+            }
+        }
+        rowCapacity = truckCapacity;
+    }
+
+    if (rows.size() < n + 1) rows.resize(n + 1);
+    if (validRows == 0) {
+        rows[0].assign(rowCapacity + 1, 0);
+        validRows = 1;
+    }
+    for (size_t i = validRows; i <= n; i++) {
+        const Pallet& pallet = items[i - 1];
+        const std::vector<int>& prev = rows[i - 1];
+        std::vector<int>& row = rows[i];
+        row.resize(rowCapacity + 1);
+        for (int c = 0; c <= rowCapacity; c++) {
+            row[c] = prev[c];
+            if (c >= pallet.weight) row[c] = std::max(row[c], prev[c - pallet.weight] + pallet.profit);
+        }
+    }
+    validRows = n + 1;
+}
+
+/**
+ * @brief Walks the table back from the lightest capacity reaching the best profit.
+ *
+ * @complexity Time: O(n + log C)
+ */
+void PackingSession::reconstructFromTable() {
+    size_t n = items.size();
+    const std::vector<int>& last = rows[n];
+    // Rows are non-decreasing in c, so the first cell with the best profit is the lightest load
+    int c = std::lower_bound(last.begin(), last.begin() + truckCapacity + 1, last[truckCapacity]) - last.begin();
+
+    loaded.assign(n, 0);
+    for (size_t i = n; i > 0; i--) {
+        if (rows[i][c] != rows[i - 1][c]) {
+            loaded[i - 1] = 1;
+            c -= items[i - 1].weight;
+        }
+    }
+    planValid = true;
+}
+
+/**
+ * @brief Repairs the previous load to the current instance and searches from it.
+ *
+ * Pallets of the worst ratio are dropped until the load fits, then the
+ * ratio greedy fills the room left. That load is the first incumbent of
+ * branchAndBoundFrom(), so after a small change most of the tree is pruned
+ * by the first bounds. The search is iterative, so long sessions with many
+ * pallets need no stack depth.
+ */
+void PackingSession::searchFromIncumbent(const CancellationToken* token) {
+    size_t n = items.size();
+    Instance instance(items, truckCapacity);
+    const RatioPrefix& rp = instance.ratioPrefix();
+
+    long long weight = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (loaded[i]) weight += items[i].weight;
+    }
+    for (auto it = rp.order.rbegin(); it != rp.order.rend() && weight > truckCapacity; ++it) {
+        if (!loaded[*it]) continue;
+        loaded[*it] = 0;
+        weight -= items[*it].weight;
+    }
+    for (int i : rp.order) {
+        if (!loaded[i] && items[i].profit > 0 && weight + items[i].weight <= truckCapacity) {
+            loaded[i] = 1;
+            weight += items[i].weight;
+        }
+    }
+
+    Solution incumbent(n);
+    for (size_t i = 0; i < n; i++) {
+        if (loaded[i]) incumbent.take(instance, i);
+    }
+
+    bool finished = true;
+    Solution best = branchAndBoundFrom(instance, incumbent, token, &finished);
+    for (size_t i = 0; i < n; i++) loaded[i] = best.taken(i);
+    planValid = finished;
+}
+
+SolveResult PackingSession::solve(const CancellationToken* token) {
+    const char* engine = "session-cached";
+    if (!planValid) {
+        if (tableFits()) {
+            rebuildRows();
+            reconstructFromTable();
+            engine = "session-dp";
+        } else {
+            // Too large for rows: free them and search instead
+            std::vector<std::vector<int>>().swap(rows);
+            validRows = 0;
+            searchFromIncumbent(token);
+            engine = "session-bnb";
+        }
+    }
+
+    SolveResult result;
+    result.solution = Solution(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        if (loaded[i]) result.solution.take(i, items[i].weight, items[i].profit);
+    }
+    result.optimal = planValid;
+    result.engine = engine;
+    return result;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file session.h
+ * @brief Stateful packing session re-planned incrementally as pallets come and go.
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <vector>
+#include "cancellation.h"
+#include "pallet.h"
+#include "solver.h"
+
+/**
+ * @class PackingSession
+ * @brief Keeps the DP table or the B&B incumbent of one truck between changes.
+ *
+ * While the table fits in memory the session keeps one DP row per pallet,
+ * in arrival order, so that:
+ *  - addPallet() costs one row, O(C), at the next solve();
+ *  - removePallet() invalidates only the rows after the pallet, and costs
+ *    nothing at all when the pallet is not in the current load, which stays
+ *    optimal;
+ *  - setCapacity() costs nothing when shrinking (the rows already cover it,
+ *    and a load that still fits stays optimal) and O(n * dC) when growing.
+ * Rows are recomputed lazily by solve(). Past the table limit the session
+ * runs a depth-first branch and bound instead, warm-started from the
+ * previous load repaired to the current pallets and capacity.
+ */
+class PackingSession {
+public:
+    /**
+     * @brief Starts an empty session.
+     * @param capacity Truck capacity
+     */
+    explicit PackingSession(int capacity);
+
+    /**
+     * @brief Adds a pallet.
+     * @return Handle for removePallet(), never reused
+     * @complexity Time: O(1)
+     */
+    int addPallet(const Pallet& pallet);
+
+    /**
+     * @brief Removes a pallet by its handle.
+     * @return False if no pallet has that handle
+     * @complexity Time: O(n)
+     */
+    bool removePallet(int id);
+
+    /**
+     * @brief Changes the truck capacity.
+     * @complexity Time: O(1), rows are extended by the next solve()
+     */
+    void setCapacity(int capacity);
+
+    /**
+     * @brief Brings the plan up to date with every change so far.
+     *
+     * @param token Stops a branch-and-bound re-plan early with its best load
+     * @return Load aligned with pallets() ({0, 0} for pallets not taken);
+     *         engine is "session-dp", "session-bnb" or "session-cached"
+     *
+     * @complexity Time: O(rows to recompute * C + n) with the table
+     */
+    SolveResult solve(const CancellationToken* token = nullptr);
+
+    const std::vector<Pallet>& pallets() const { return items; }
+    const std::vector<int>& ids() const { return handles; }
+    int capacity() const { return truckCapacity; }
+
+    /// Largest table, in cells, the session keeps (64 MB of int rows)
+    static const long long tableCellLimit = 1LL << 24;
+
+private:
+    bool tableFits() const;
+    void rebuildRows();
+    void reconstructFromTable();
+    void searchFromIncumbent(const CancellationToken* token);
+
+    std::vector<Pallet> items;          ///< Pallets in arrival order
+    std::vector<int> handles;           ///< Handle of every pallet
+    int nextHandle = 0;
+    int truckCapacity;
+
+    std::vector<std::vector<int>> rows; ///< rows[i][c]: best profit of items[0..i) within c
+    size_t validRows = 0;               ///< rows[0..validRows) are up to date
+    int rowCapacity = 0;                ///< Capacity the valid rows cover
+
+    std::vector<char> loaded;           ///< Current load, aligned with items
+    bool planValid = true;              ///< loaded is optimal for the current instance
+};
+
+#endif // SESSION_H
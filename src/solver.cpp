@@ -0,0 +1,218 @@
+/**
+ * @file solver.cpp
+ * @brief Solver registry and the automatic engine selection.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include "algorithms.h"
+#include "kernels.h"
+#include "solver.h"
+
+// ====================================================================== //
+// ============================== REGISTRY ============================== //
+// ====================================================================== //
+
+SolveResult makeResult(Solution solution, bool exact, const SolveOptions& options, const char* engine) {
+    SolveResult result;
+    result.solution = std::move(solution);
+    result.optimal = exact && !stopRequested(options.token);
+    result.engine = engine;
+    return result;
+}
+
+/**
+ * @brief Name of the SIMD DP with the instruction set its kernels run on.
+ *
+ * Each cell width picks its own best kernel, and without AVX2 the 64-bit
+ * cells fall back to scalar code, so that exception is spelled out.
+ */
+std::string simdDpName() {
+    std::string narrow = bestKnapsackKernel<uint32_t>().name;
+    std::string wide = bestKnapsackKernel<uint64_t>().name;
+    std::string kernels = narrow == wide ? narrow : narrow + "; " + wide + " for 64-bit cells";
+    return "Dynamic Programming (SIMD, " + kernels + ")";
+}
+
+const std::vector<Solver>& solverRegistry() {
+    typedef const Instance& Items;
+    static const std::vector<Solver> solvers = {
+        {"exhaustive", "Exhaustive Search", true, [](Items p, const SolveOptions& o) {
+            // Past its pallet limit the search returns the empty load unsolved
+            return makeResult(exhaustiveSearch(p, o.threads, o.token), p.size() <= 63, o, "exhaustive");
+        }},
+        {"backtracking", "Backtracking", true, [](Items p, const SolveOptions& o) {
+            long long nodes = 0;
+            SolveResult result = makeResult(backtracking(p, o.token, &nodes), true, o, "backtracking");
+            result.nodes = nodes;
+            return result;
+        }},
+        {"dp", "Dynamic Programming", true, [](Items p, const SolveOptions& o) {
+            return makeResult(dynamicProgramming(p, o.token), true, o, "dp");
+        }},
+        {"greedy", "Approximation", false, [](Items p, const SolveOptions& o) {
+            return makeResult(approximationAlgorithm(p), false, o, "greedy");
+        }},
+        {"ilp", "ILP", true, [](Items p, const SolveOptions& o) {
+            long long nodes = 0;
+            SolveResult result = makeResult(integerLinearProgramming(p, o.token, &nodes), true, o, "ilp");
+            result.nodes = nodes;
+            return result;
+        }},
+        {"dp-linear", "Dynamic Programming (Linear Memory)", true, [](Items p, const SolveOptions& o) {
+            return makeResult(dynamicProgrammingLinear(p, o.token), true, o, "dp-linear");
+        }},
+        {"dp-bitset", "Dynamic Programming (Bitset)", true, [](Items p, const SolveOptions& o) {
+            return makeResult(dynamicProgrammingBitset(p, o.token), true, o, "dp-bitset");
+        }},
+        {"dp-simd", simdDpName(), true, [](Items p, const SolveOptions& o) {
+            return makeResult(dynamicProgrammingSIMD(p, o.token), true, o, "dp-simd");
+        }},
+        {"dp-parallel", "Dynamic Programming (Parallel)", true, [](Items p, const SolveOptions& o) {
+            return makeResult(dynamicProgrammingParallel(p, o.threads, o.token), true, o, "dp-parallel");
+        }},
+        {"sparse", "Sparse Dynamic Programming", true, [](Items p, const SolveOptions& o) {
+            return makeResult(sparseDynamicProgramming(p, o.token), true, o, "sparse");
+        }},
+        {"mitm", "Meet in the Middle", true, [](Items p, const SolveOptions& o) {
+            return makeResult(meetInTheMiddle(p, o.token), p.size() <= 64, o, "mitm");
+        }},
+        {"bnb", "Branch and Bound", true, [](Items p, const SolveOptions& o) {
+            long long nodes = 0;
+            SolveResult result = makeResult(branchAndBound(p, true, 1 << 22, o.token, &nodes), true, o, "bnb");
+            result.nodes = nodes;
+            return result;
+        }},
+        {"bnb-parallel", "Parallel Branch and Bound", true, [](Items p, const SolveOptions& o) {
+            return makeResult(parallelBranchAndBound(p, o.threads, o.token), true, o, "bnb-parallel");
+        }},
+        {"core", "Core Problem", true, [](Items p, const SolveOptions& o) {
+            return makeResult(coreProblemSolver(p, o.token), true, o, "core");
+        }},
+        {"fptas", "FPTAS", false, [](Items p, const SolveOptions& o) {
+            SolveResult result = makeResult({}, false, o, "fptas");
+            result.solution = fptasApproximation(p, o.epsilon, &result.upperBound, o.token);
+            return result;
+        }},
+        {"anytime", "Anytime Branch and Bound", false, [](Items p, const SolveOptions& o) {
+            auto deadline = o.budget.count() > 0 ? std::chrono::steady_clock::now() + o.budget
+                                                 : std::chrono::steady_clock::time_point::max();
+            CancellationToken never;
+            AnytimeResult anytime = anytimeSolve(p, deadline, o.token ? *o.token : never);
+            SolveResult result = makeResult(anytime.solution, false, o, "anytime");
+            result.optimal = anytime.optimal;
+            result.nodes = anytime.nodes;
+            if (!anytime.optimal) result.upperBound = anytime.upperBound;
+            return result;
+        }},
+        {"auto", "Automatic", true, autoSolve},
+    };
+    return solvers;
+}
+
+const Solver* findSolver(const std::string& key) {
+    for (const Solver& solver : solverRegistry()) {
+        if (solver.key == key) return &solver;
+    }
+    return nullptr;
+}
+
+// ====================================================================== //
+// ========================= AUTOMATIC SELECTION ======================== //
+// ====================================================================== //
+
+InstanceProfile profileInstance(const Instance& instance) {
+    int capacity = instance.capacity();
+    InstanceProfile profile{(int)instance.size(), capacity, instance.totalWeight(), 0.0, 0, 0.0};
+    profile.cells = (double)profile.n * ((double)std::max(capacity, 0) + 1);
+    profile.cellBits = knapsackValueBits(instance.profitCeiling());
+
+    double sumW = instance.totalWeight(), sumP = instance.totalProfit(), sumWW = 0, sumPP = 0, sumWP = 0;
+    const int* w = instance.weights();
+    const int* p = instance.profits();
+    for (int i = 0; i < profile.n; i++) {
+        sumWW += (double)w[i] * w[i];
+        sumPP += (double)p[i] * p[i];
+        sumWP += (double)w[i] * p[i];
+    }
+    if (profile.n > 1) {
+        double n = profile.n;
+        double covariance = sumWP - sumW * sumP / n;
+        double spread = std::sqrt((sumWW - sumW * sumW / n) * (sumPP - sumP * sumP / n));
+        // Equal weights or equal profits leave nothing to correlate
+        if (spread > 0) profile.correlation = covariance / spread;
+    }
+    return profile;
+}
+
+/**
+ * @brief Selects and runs an engine from the instance profile and the time budget.
+ *
+ * Rules, in order:
+ *  - every pallet fits: the core solver takes them all in O(n log n);
+ *  - n <= 20: exhaustive search, 2^n subsets cost less than any setup;
+ *  - the DP table is small enough (and fast enough for the budget): the
+ *    SIMD DP, or the parallel DP when threads and capacity allow;
+ *  - a budget is set: anytime search, which answers in time with a bound;
+ *  - weight and profit strongly correlated: bounds are weak, so meet in
+ *    the middle for n <= 40 and the core solver beyond;
+ *  - otherwise: best-first branch and bound, whose bounds prune well.
+ *
+ * @complexity Time: O(n) for the choice, plus the chosen engine
+ */
+SolveResult autoSolve(const Instance& instance, const SolveOptions& options) {
+    auto fixed2 = [](double value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.2f", value);
+        return std::string(buf);
+    };
+
+    // Cells per second of the SIMD DP: AVX2 does about 5e9 on one core, scalar about 1e9
+    const double dpCellsPerSecond = 2e9;
+    // Largest table the DP may use: 2^28 cells are 32 MB of decision bits
+    const double dpCellLimit = (double)(1 << 28);
+    const double strongCorrelation = 0.9;
+
+    InstanceProfile profile = profileInstance(instance);
+    int capacity = instance.capacity();
+    int threads = options.threads > 0 ? options.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    double dpSeconds = profile.cells / dpCellsPerSecond;
+    double budgetSeconds = options.budget.count() / 1000.0;
+
+    std::string key, reason;
+    if (profile.totalWeight <= capacity) {
+        key = "core";
+        reason = "all pallets fit, nothing to decide";
+    } else if (profile.n <= 20) {
+        key = "exhaustive";
+        reason = "n = " + std::to_string(profile.n) + ", 2^n subsets are cheaper than any setup";
+    } else if (profile.cells <= dpCellLimit && (budgetSeconds == 0 || dpSeconds <= budgetSeconds)) {
+        // Mirrors the per-thread minimum slice of dynamicProgrammingParallel()
+        bool parallel = threads > 1 && (capacity / 64 + 1) >= 2 * 64;
+        key = parallel ? "dp-parallel" : "dp-simd";
+        reason = "n*C = " + std::to_string((long long)profile.cells) + " cells of " +
+                 std::to_string(profile.cellBits) + " bits, about " +
+                 std::to_string((long long)std::ceil(dpSeconds * 1000)) + " ms of DP";
+    } else if (budgetSeconds > 0) {
+        key = "anytime";
+        reason = "DP table too large for the " + std::to_string(options.budget.count()) +
+                 " ms budget, anytime search answers in time with a bound";
+    } else if (std::abs(profile.correlation) >= strongCorrelation) {
+        key = profile.n <= 40 ? "mitm" : "core";
+        reason = "weight/profit correlation " + fixed2(profile.correlation) +
+                 (profile.n <= 40 ? " weakens bounds, n <= 40 suits meet in the middle"
+                                  : " weakens bounds, the core keeps the exact search near the break item");
+    } else {
+        key = "bnb";
+        reason = "weight/profit correlation " + fixed2(profile.correlation) +
+                 ", Martello-Toth bounds prune well";
+    }
+
+    if (options.log) *options.log << "auto: using " << key << " (" << reason << ")\n";
+
+    SolveResult result = findSolver(key)->solve(instance, options);
+    result.reason = reason;
+    return result;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file solver.h
+ * @brief Uniform interface over the knapsack algorithms, with automatic engine selection.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "cancellation.h"
+#include "instance.h"
+
+/**
+ * @struct SolveOptions
+ * @brief Tuning knobs shared by every engine; each engine reads the ones it needs.
+ */
+struct SolveOptions {
+    int threads = 0;                             ///< Worker threads for parallel engines (0 = all)
+    const CancellationToken* token = nullptr;    ///< Optional stop request
+    double epsilon = 0.1;                        ///< Relative loss allowed by the FPTAS
+    std::chrono::milliseconds budget{0};         ///< Time budget for anytime/auto (0 = none)
+    std::ostream* log = nullptr;                 ///< Where the auto strategy explains its choice
+};
+
+/**
+ * @struct SolveResult
+ * @brief Load returned by an engine, with what is known about its quality.
+ */
+struct SolveResult {
+    Solution solution;            ///< Selected pallets with their totals
+    bool optimal = false;         ///< True if the load is proven optimal
+    long long upperBound = -1;    ///< Proven bound on the optimum when not optimal, -1 if unknown
+    long long nodes = -1;         ///< Search nodes expanded, -1 for engines that do not count them
+    std::string engine;           ///< Key of the engine that produced the load
+    std::string reason;           ///< Why the auto strategy picked that engine (empty otherwise)
+};
+
+typedef SolveResult (*SolverFunction)(const Instance& instance, const SolveOptions& options);
+
+/**
+ * @struct Solver
+ * @brief One registered engine.
+ */
+struct Solver {
+    std::string key;       ///< Short identifier, e.g. "dp-simd"
+    std::string name;      ///< Human-readable name used in menus and benchmark output
+    bool exact;            ///< Whether a completed run is always optimal
+    SolverFunction solve;  ///< Entry point
+};
+
+/**
+ * @struct InstanceProfile
+ * @brief Instance features the auto strategy bases its choice on.
+ */
+struct InstanceProfile {
+    int n;                    ///< Number of pallets
+    int capacity;             ///< Truck capacity
+    long long totalWeight;    ///< Sum of all pallet weights
+    double cells;             ///< n * (capacity + 1), the size of a DP table
+    int cellBits;             ///< Width of the DP cells, see knapsackValueBits()
+    double correlation;       ///< Pearson correlation of weight and profit
+};
+
+/**
+ * @brief Every engine, in menu order; the last entry is the auto strategy.
+ */
+const std::vector<Solver>& solverRegistry();
+
+/**
+ * @brief Looks an engine up by key.
+ * @return The engine, or nullptr if no engine has that key
+ */
+const Solver* findSolver(const std::string& key);
+
+/**
+ * @brief Wraps the load of an engine into a SolveResult.
+ *
+ * An exact engine is optimal unless the token stopped it early.
+ */
+SolveResult makeResult(Solution solution, bool exact, const SolveOptions& options, const char* engine);
+
+/**
+ * @brief Computes the features used by autoSolve().
+ *
+ * @complexity Time: O(n)
+ */
+InstanceProfile profileInstance(const Instance& instance);
+
+/**
+ * @brief Picks the engine expected to be fastest for the instance and runs it.
+ *
+ * The choice and its reason are written to options.log when set and are
+ * also returned in the result.
+ */
+SolveResult autoSolve(const Instance& instance, const SolveOptions& options);
+
+#endif // SOLVER_H
@@ -0,0 +1,104 @@
+/**
+ * @file threadpool.cpp
+ * @brief Implementation of the work-stealing thread pool.
+ */
+
+#include <algorithm>
+#include "threadpool.h"
+
+namespace {
+    thread_local const WorkStealingPool* currentPool = nullptr;
+    thread_local int currentIndex = -1;
+}
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : queued(0), unfinished(0), nextQueue(0), stopping(false) {
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threads; i++) {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(&WorkStealingPool::run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+int WorkStealingPool::currentWorker() {
+    return currentIndex;
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    int index = (currentPool == this) ? currentIndex : (int)(nextQueue++ % queues.size());
+    unfinished++;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Publishing under the state mutex avoids a lost wake-up
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queued++;
+    }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return unfinished == 0; });
+}
+
+bool WorkStealingPool::popTask(int index, std::function<void()>& task) {
+    {
+        TaskQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        TaskQueue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(int index) {
+    currentPool = this;
+    currentIndex = index;
+
+    std::function<void()> task;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0) return;
+        }
+
+        if (!popTask(index, task)) continue;
+        task();
+        task = nullptr;
+
+        if (--unfinished == 0) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            allDone.notify_all();
+        }
+    }
+}
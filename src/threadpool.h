@@ -0,0 +1,85 @@
+/**
+ * @file threadpool.h
+ * @brief Work-stealing thread pool used by the parallel solvers.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Fixed set of workers, each with its own task deque.
+ *
+ * A task submitted from inside a worker goes to the back of that worker's
+ * deque and is popped from the back (depth-first, cache-friendly). Idle
+ * workers steal from the front of other deques, where the oldest and
+ * usually largest tasks sit. Tasks submitted from outside the pool are
+ * spread round-robin.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Starts the workers.
+     * @param threads Number of workers (0 = all hardware threads)
+     */
+    explicit WorkStealingPool(int threads = 0);
+
+    /**
+     * @brief Waits for all pending tasks and joins the workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queues a task. Safe to call from tasks running on the pool.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task, including tasks they spawned, has finished.
+     */
+    void wait();
+
+    /**
+     * @brief Number of worker threads.
+     */
+    int size() const { return workers.size(); }
+
+    /**
+     * @brief Index of the calling worker in its pool, or -1 outside any pool.
+     */
+    static int currentWorker();
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void run(int index);
+    bool popTask(int index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<long> queued;       ///< Tasks waiting in a deque (may dip below 0 briefly)
+    std::atomic<size_t> unfinished; ///< Tasks submitted and not yet completed
+    std::atomic<size_t> nextQueue;  ///< Round-robin target for outside submissions
+    bool stopping;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+};
+
+#endif // THREADPOOL_H
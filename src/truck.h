@@ -0,0 +1,26 @@
+/**
+ * @file truck.h
+ * @brief Definition of the Truck data structure.
+ */
+
+#ifndef TRUCK_H
+#define TRUCK_H
+
+/**
+ * @struct Truck
+ * @brief Represents one truck of a fleet.
+ *
+ * Used by the multiple knapsack (fleet) solver, where one pool of pallets
+ * is shared among several trucks of possibly different capacities, and by
+ * the multi-dimensional solver. A negative limit means no limit.
+ */
+struct Truck {
+    int id;              ///< Identifier from the trucks file (1-based line number if absent)
+    int capacity;        ///< Maximum weight the truck can carry
+    int volume = -1;     ///< Cargo volume
+    int slots = -1;      ///< Floor positions
+    int frontAxle = -1;  ///< Maximum load on the front axle
+    int rearAxle = -1;   ///< Maximum load on the rear axle
+};
+
+#endif // TRUCK_H